@@ -0,0 +1,218 @@
+//
+// One-dimensional model of the RKL2 super-time-stepping integrator of
+// Diffusion::diffuse_scalar_sts(), used to check its order and its
+// conservation independently of IAMR and AMReX.
+//
+// It integrates rho dphi/dt = mu phi_xx + rho R on [0,1] with R = 1 and
+// the time-dependent Dirichlet values of the exact solution
+//
+//   phi(x,t) = exp(-mu k^2 t / rho) sin(k x) + t
+//
+// with the same stage recurrence, stage times and accumulated stage fluxes
+// as IAMR.  Starting from diffusion numbers mu dt/(rho dx^2) of about 128,
+// 1280 and 6400 it halves dt four times and prints the maximum error against the exact
+// solution and, to separate the time error from the space error, the
+// difference to the run with the next smaller dt and the order observed
+// from it.  Also printed is the largest difference between the final
+// stage and the old state updated with the accumulated fluxes, i.e. what
+// the reflux would see.  The exit status is nonzero if the order drops
+// below 1.8, the conservation error exceeds 1e-10 or the last stage time
+// is not the end of the step.
+//
+// Build and run with
+//
+//   g++ -O2 -o rkl2_1d RKL2_1d.cpp && ./rkl2_1d
+//
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+    typedef std::vector<double> Vec;
+
+    const double Pi  = 3.14159265358979323846;
+    const double mu  = 1.0;
+    const double rho = 1.0;
+    const double k   = Pi;
+
+    double
+    exact (double x, double t)
+    {
+        return std::exp(-mu*k*k*t/rho)*std::sin(k*x) + t;
+    }
+    //
+    // The flux -mu dphi/dx on the n+1 faces, with the boundary values at t.
+    //
+    void
+    flux (const Vec& y, int n, double dx, double t, Vec& F)
+    {
+        for (int i = 0; i <= n; i++)
+        {
+            const double l = (i == 0) ? 2*exact(0,t) - y[0]   : y[i-1];
+            const double r = (i == n) ? 2*exact(1,t) - y[n-1] : y[i];
+
+            F[i] = -mu*(r - l)/dx;
+        }
+    }
+    //
+    // The flux F and the rate M = R - Div(F)/rho of y at t.
+    //
+    void
+    eval (const Vec& y, int n, double dx, double t, const Vec& R, Vec& F, Vec& M)
+    {
+        flux(y,n,dx,t,F);
+
+        for (int i = 0; i < n; i++)
+            M[i] = R[i] - (F[i+1] - F[i])/(dx*rho);
+    }
+
+    double
+    bj (int j)
+    {
+        return (j < 2) ? 1.0/3.0 : (j*j+j-2.0)/(2.0*j*(j+1.0));
+    }
+
+    struct Result
+    {
+        int    stages;
+        Vec    y;
+        double error;
+        double cons;
+        double cs;
+    };
+    //
+    // N steps of RKL2 to T on n cells, with the stage count IAMR would take.
+    //
+    Result
+    run (int n, int N, double T)
+    {
+        const double dx    = 1.0/n;
+        const double dt    = T/N;
+        const double ratio = 2*mu*dt/(rho*dx*dx);
+        int          s     = int(0.5*(std::sqrt(9.0 + 16.0*ratio) - 1.0)) + 1;
+        if (s % 2 == 0)
+            s++;
+        const double w1 = 4.0/(s*s+s-2.0);
+
+        Vec y(n), R(n,1.0);
+        for (int i = 0; i < n; i++)
+            y[i] = exact((i+0.5)*dx,0);
+
+        Result res = { s, Vec(), 0, 0, 1 };
+        double t   = 0;
+
+        for (int step = 0; step < N; step++)
+        {
+            Vec Y0 = y, Yjm1(n), Yjm2 = y, Yj(n), M0(n), Mj(n);
+            Vec G0(n+1), Gj(n+1), Fjm1(n+1), Fjm2(n+1,0.0), Fj(n+1);
+
+            eval(Y0,n,dx,t,R,G0,M0);
+
+            const double mt1 = bj(1)*w1;
+
+            for (int i = 0; i < n;  i++) Yjm1[i] = Y0[i] + mt1*dt*M0[i];
+            for (int i = 0; i <= n; i++) Fjm1[i] = mt1*dt*G0[i];
+
+            double cjm1 = mt1, cjm2 = 0;
+
+            for (int j = 2; j <= s; j++)
+            {
+                eval(Yjm1,n,dx,t+cjm1*dt,R,Gj,Mj);
+
+                const double muj = (2.0*j-1.0)/j * bj(j)/bj(j-1);
+                const double nuj = -(j-1.0)/j * bj(j)/bj(j-2);
+                const double mt  = muj*w1;
+                const double gt  = -(1.0-bj(j-1))*mt;
+
+                for (int i = 0; i < n; i++)
+                    Yj[i] = muj*Yjm1[i] + nuj*Yjm2[i] + (1.0-muj-nuj)*Y0[i]
+                          + mt*dt*Mj[i] + gt*dt*M0[i];
+                for (int i = 0; i <= n; i++)
+                    Fj[i] = muj*Fjm1[i] + nuj*Fjm2[i] + mt*dt*Gj[i] + gt*dt*G0[i];
+
+                const double cj = muj*cjm1 + nuj*cjm2 + mt + gt;
+
+                Yjm2.swap(Yjm1);
+                Yjm1.swap(Yj);
+                Fjm2.swap(Fjm1);
+                Fjm1.swap(Fj);
+                cjm2 = cjm1;
+                cjm1 = cj;
+            }
+            //
+            // The final stage against the old state updated with the
+            // accumulated fluxes.
+            //
+            for (int i = 0; i < n; i++)
+            {
+                const double z = Y0[i] + cjm1*dt*R[i] - (Fjm1[i+1] - Fjm1[i])/(dx*rho);
+                res.cons = std::max(res.cons, std::fabs(z - Yjm1[i]));
+            }
+            if (std::fabs(cjm1 - 1) > std::fabs(res.cs - 1))
+                res.cs = cjm1;
+
+            y  = Yjm1;
+            t += dt;
+        }
+
+        for (int i = 0; i < n; i++)
+            res.error = std::max(res.error, std::fabs(y[i] - exact((i+0.5)*dx,t)));
+
+        res.y.swap(y);
+
+        return res;
+    }
+}
+
+int
+main ()
+{
+    const int    n      = 400;
+    const double dx     = 1.0/n;
+    const double T      = 0.05;
+    const double dnum[] = { 128.0, 1280.0, 6400.0 };
+    const int    nref   = 5;
+
+    bool ok = true;
+
+    for (int m = 0; m < 3; m++)
+    {
+        const int N0 = std::max(1, int(std::floor(T/(dnum[m]*dx*dx) + 0.5)));
+
+        std::vector<Result> res(nref);
+
+        for (int r = 0; r < nref; r++)
+            res[r] = run(n,N0<<r,T);
+
+        double prev = 0;
+
+        for (int r = 0; r < nref; r++)
+        {
+            double diff = 0;
+            if (r+1 < nref)
+            {
+                for (int i = 0; i < n; i++)
+                    diff = std::max(diff, std::fabs(res[r].y[i] - res[r+1].y[i]));
+            }
+            const double order = (prev > 0 && diff > 0) ? std::log2(prev/diff) : 0;
+
+            std::printf("dt %.3e  stages %3d  error %.3e  time error %.3e  order %5.2f"
+                        "  conservation %.2e  c_s %.15f\n",
+                        T/(N0<<r), res[r].stages, res[r].error, diff, order,
+                        res[r].cons, res[r].cs);
+
+            if ((prev > 0 && diff > 0 && order < 1.8) || res[r].cons > 1e-10 ||
+                std::fabs(res[r].cs - 1) > 1e-12)
+                ok = false;
+
+            prev = diff;
+        }
+    }
+
+    std::printf(ok ? "RKL2_1d: passed\n" : "RKL2_1d: FAILED\n");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,486 @@
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+
+#include <DeltaCheckpoint.H>
+
+using namespace amrex;
+
+namespace
+{
+    const std::string delta_header_name("DeltaHeader");
+    const std::string delta_version("DeltaCheckpoint_V1");
+    //
+    // The suffixes StateData::checkPoint() gives the MultiFabs it writes.
+    //
+    const std::string new_suffix("_New_MF");
+    const std::string old_suffix("_Old_MF");
+    //
+    // The number of MultiFabs StateData::checkPoint() writes for sd.
+    //
+    int
+    numSets (StateData& sd, bool dump_old)
+    {
+        if (!sd.descriptor()->store_in_checkpoint())
+            return 0;
+        return (dump_old && sd.hasOldData()) ? 2 : 1;
+    }
+
+    std::string
+    sdName (const std::string& LevelDir, int i)
+    {
+        return amrex::Concatenate(LevelDir + "/SD_", i, 1);
+    }
+}
+
+void
+DeltaCheckpoint::clear ()
+{
+    base_name.clear();
+    chain.clear();
+    n_since_base = 0;
+    have_base    = false;
+    base_nsets.clear();
+    base_grids   = BoxArray();
+    base_dmap    = DistributionMapping();
+    new_hash.clear();
+    old_hash.clear();
+}
+
+unsigned long long
+DeltaCheckpoint::hashFab (const FArrayBox& fab)
+{
+    //
+    // FNV-1a over 64-bit words, with a final avalanche step.
+    //
+    const unsigned long long prime = 1099511628211ULL;
+    unsigned long long h = 14695981039346656037ULL;
+
+    const long nbytes = fab.size()*sizeof(Real);
+    const long nwords = nbytes / sizeof(unsigned long long);
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(fab.dataPtr());
+
+    for (long i = 0; i < nwords; i++)
+    {
+        unsigned long long w;
+        std::memcpy(&w, p + i*sizeof(unsigned long long), sizeof(w));
+        h = (h ^ w) * prime;
+    }
+    for (long i = nwords*sizeof(unsigned long long); i < nbytes; i++)
+    {
+        h = (h ^ p[i]) * prime;
+    }
+
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+
+    return h;
+}
+
+void
+DeltaCheckpoint::hashMultiFab (const MultiFab& mf, HashVec& hash)
+{
+    hash.resize(mf.size());
+    std::fill(hash.begin(), hash.end(), 0);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        hash[mfi.index()] = hashFab(mf[mfi]);
+    }
+}
+
+std::string
+DeltaCheckpoint::finalName (const std::string& dir)
+{
+    //
+    // Amr writes into <chkfile>.temp and renames the directory at the end.
+    //
+    std::string name(dir);
+    while (name.size() > 1 && name[name.size()-1] == '/')
+        name.erase(name.size()-1);
+
+    const std::string temp(".temp");
+    if (name.size() > temp.size() &&
+        name.compare(name.size()-temp.size(), temp.size(), temp) == 0)
+    {
+        name.erase(name.size()-temp.size());
+    }
+    return name;
+}
+
+std::string
+DeltaCheckpoint::baseName (const std::string& dir)
+{
+    const std::string name = finalName(dir);
+    const std::string::size_type pos = name.rfind('/');
+    return (pos == std::string::npos) ? name : name.substr(pos+1);
+}
+
+bool
+DeltaCheckpoint::canWriteDelta (AmrLevel& lev,
+                                bool      dump_old,
+                                int       full_int)
+{
+    if (!have_base || full_int <= 1 || n_since_base >= full_int-1)
+        return false;
+
+    if (!(lev.boxArray() == base_grids) || !(lev.DistributionMap() == base_dmap))
+        return false;
+
+    const int ndesc = AmrLevel::get_desc_lst().size();
+
+    if (base_nsets.size() != ndesc)
+        return false;
+
+    for (int i = 0; i < ndesc; i++)
+    {
+        if (numSets(lev.get_state_data(i),dump_old) != base_nsets[i])
+            return false;
+    }
+
+    return true;
+}
+
+void
+DeltaCheckpoint::setBase (AmrLevel&          lev,
+                          const std::string& dir,
+                          bool               dump_old)
+{
+    BL_PROFILE("DeltaCheckpoint::setBase()");
+
+    clear();
+
+    const int ndesc = AmrLevel::get_desc_lst().size();
+
+    base_name  = baseName(dir);
+    base_grids = lev.boxArray();
+    base_dmap  = lev.DistributionMap();
+    base_nsets.resize(ndesc);
+    new_hash.resize(ndesc);
+    old_hash.resize(ndesc);
+
+    for (int i = 0; i < ndesc; i++)
+    {
+        StateData& sd = lev.get_state_data(i);
+
+        base_nsets[i] = numSets(sd,dump_old);
+
+        if (base_nsets[i] > 0)
+            hashMultiFab(sd.newData(), new_hash[i]);
+        if (base_nsets[i] > 1)
+            hashMultiFab(sd.oldData(), old_hash[i]);
+    }
+
+    have_base = true;
+}
+
+Vector<int>
+DeltaCheckpoint::findChanged (const MultiFab& mf, HashVec& hash)
+{
+    BL_ASSERT(hash.size() == mf.size());
+
+    const int N = mf.size();
+
+    Vector<int> changed(N, 0);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const int i = mfi.index();
+        const unsigned long long h = hashFab(mf[mfi]);
+        if (h != hash[i])
+        {
+            changed[i] = 1;
+            hash[i]    = h;
+        }
+    }
+
+    ParallelDescriptor::ReduceIntMax(changed.dataPtr(), N);
+
+    Vector<int> idx;
+    for (int i = 0; i < N; i++)
+        if (changed[i])
+            idx.push_back(i);
+
+    return idx;
+}
+
+void
+DeltaCheckpoint::writeChanged (const MultiFab&    mf,
+                               const Vector<int>& idx,
+                               const std::string& fullpath,
+                               VisMF::How         how)
+{
+    if (idx.empty()) return;
+    //
+    // Build a MultiFab over the changed boxes, owned by the same ranks,
+    // so that gathering the data involves no communication.
+    //
+    const BoxArray&            ba = mf.boxArray();
+    const DistributionMapping& dm = mf.DistributionMap();
+
+    BoxList     bl(ba.ixType());
+    Vector<int> pmap(idx.size());
+
+    for (int j = 0; j < idx.size(); j++)
+    {
+        bl.push_back(ba[idx[j]]);
+        pmap[j] = dm[idx[j]];
+    }
+
+    MultiFab delta(BoxArray(bl), DistributionMapping(pmap), mf.nComp(), mf.nGrow());
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(delta); mfi.isValid(); ++mfi)
+    {
+        delta[mfi].copy(mf[idx[mfi.index()]]);
+    }
+
+    VisMF::Write(delta, fullpath, how);
+}
+
+void
+DeltaCheckpoint::writeHeader (AmrLevel&          lev,
+                              std::ostream&      os,
+                              const std::string& prefix) const
+{
+    if (!ParallelDescriptor::IOProcessor())
+        return;
+
+    const int         ndesc    = AmrLevel::get_desc_lst().size();
+    const std::string LevelDir = amrex::Concatenate("Level_", lev.Level(), 1);
+    //
+    // What AmrLevel::checkPoint() and StateData::checkPoint() write, taken
+    // from the level and its StateData.
+    //
+    os << lev.Level() << '\n' << lev.Geom() << '\n';
+    lev.boxArray().writeOn(os);
+    os << ndesc << '\n';
+
+    for (int i = 0; i < ndesc; i++)
+    {
+        const StateData&               sd       = lev.get_state_data(i);
+        const StateData::TimeInterval& new_time = sd.getNewTimeInterval();
+        const StateData::TimeInterval& old_time = sd.getOldTimeInterval();
+        const std::string              mf_name  = prefix + sdName(LevelDir, i);
+
+        os << sd.getDomain() << '\n';
+        sd.boxArray().writeOn(os);
+        os << new_time.start << '\n'
+           << new_time.stop  << '\n'
+           << old_time.start << '\n'
+           << old_time.stop  << '\n';
+
+        os << base_nsets[i] << '\n';
+        if (base_nsets[i] > 0)
+            os << mf_name << new_suffix << '\n';
+        if (base_nsets[i] > 1)
+            os << mf_name << old_suffix << '\n';
+    }
+}
+
+void
+DeltaCheckpoint::writeDelta (AmrLevel&          lev,
+                             const std::string& dir,
+                             std::ostream&      os,
+                             VisMF::How         how,
+                             bool               dump_old)
+{
+    BL_PROFILE("DeltaCheckpoint::writeDelta()");
+
+    BL_ASSERT(have_base);
+
+    const int ndesc = AmrLevel::get_desc_lst().size();
+    const int level = lev.Level();
+
+    const std::string LevelDir = amrex::Concatenate("Level_", level, 1);
+    const std::string FullPath = dir + "/" + LevelDir;
+
+    if (ParallelDescriptor::IOProcessor())
+        if (!amrex::UtilCreateDirectory(FullPath, 0755))
+            amrex::CreateDirectoryFailed(FullPath);
+    ParallelDescriptor::Barrier("DeltaCheckpoint::writeDelta::dir");
+    writeHeader(lev, os, "../" + base_name + "/");
+
+    Vector<Vector<int> > new_idx(ndesc), old_idx(ndesc);
+
+    for (int i = 0; i < ndesc; i++)
+    {
+        StateData&        sd           = lev.get_state_data(i);
+        const std::string FullPathName = sdName(FullPath, i);
+
+        if (base_nsets[i] > 0)
+        {
+            new_idx[i] = findChanged(sd.newData(), new_hash[i]);
+            writeChanged(sd.newData(), new_idx[i], FullPathName + "_Delta_New", how);
+        }
+        if (base_nsets[i] > 1)
+        {
+            old_idx[i] = findChanged(sd.oldData(), old_hash[i]);
+            writeChanged(sd.oldData(), old_idx[i], FullPathName + "_Delta_Old", how);
+        }
+    }
+
+    chain.push_back(baseName(dir));
+    n_since_base++;
+    //
+    // Record the chain of deltas since the base and the boxes of this one.
+    //
+    if (ParallelDescriptor::IOProcessor())
+    {
+        const std::string hdr = FullPath + "/" + delta_header_name;
+
+        std::ofstream ofs(hdr.c_str());
+        if (!ofs.good())
+            amrex::FileOpenFailed(hdr);
+
+        ofs << delta_version << '\n';
+        ofs << base_name     << '\n';
+        ofs << chain.size()  << '\n';
+        for (int j = 0; j < chain.size(); j++)
+            ofs << chain[j] << '\n';
+
+        ofs << ndesc << '\n';
+        for (int i = 0; i < ndesc; i++)
+        {
+            ofs << new_idx[i].size();
+            for (int j = 0; j < new_idx[i].size(); j++)
+                ofs << ' ' << new_idx[i][j];
+            ofs << '\n';
+            ofs << old_idx[i].size();
+            for (int j = 0; j < old_idx[i].size(); j++)
+                ofs << ' ' << old_idx[i][j];
+            ofs << '\n';
+        }
+    }
+
+    if (lev.Level() == 0)
+    {
+        amrex::Print() << "DeltaCheckpoint: wrote delta " << n_since_base
+                       << " against base " << base_name << '\n';
+    }
+}
+
+void
+DeltaCheckpoint::replay (AmrLevel& lev, const std::string& chkfile)
+{
+    BL_PROFILE("DeltaCheckpoint::replay()");
+
+    const std::string LevelDir = amrex::Concatenate("Level_", lev.Level(), 1);
+    //
+    // Deltas live in sibling directories of the restart file.
+    //
+    std::string parent_dir = finalName(chkfile);
+    const std::string::size_type pos = parent_dir.rfind('/');
+    parent_dir = (pos == std::string::npos) ? std::string() : parent_dir.substr(0, pos+1);
+
+    const std::string hdr = finalName(chkfile) + "/" + LevelDir + "/" + delta_header_name;
+
+    int is_delta = 0;
+    if (ParallelDescriptor::IOProcessor())
+    {
+        std::ifstream ifs(hdr.c_str());
+        is_delta = ifs.good();
+    }
+    ParallelDescriptor::Bcast(&is_delta, 1, ParallelDescriptor::IOProcessorNumber());
+
+    if (!is_delta) return;
+
+    Vector<std::string> dchain;
+    {
+        Vector<char> buf;
+        ParallelDescriptor::ReadAndBcastFile(hdr, buf);
+        std::istringstream is(buf.dataPtr(), std::istringstream::in);
+
+        std::string version, base;
+        int nchain;
+        is >> version >> base >> nchain;
+        if (version != delta_version)
+            amrex::Abort("DeltaCheckpoint::replay(): unknown version " + version);
+
+        dchain.resize(nchain);
+        for (int j = 0; j < nchain; j++)
+            is >> dchain[j];
+
+        amrex::Print() << "DeltaCheckpoint: replaying " << nchain
+                       << " delta(s) on base " << base
+                       << " at level " << lev.Level() << '\n';
+    }
+
+    for (int c = 0; c < dchain.size(); c++)
+    {
+        const std::string FullPath = parent_dir + dchain[c] + "/" + LevelDir;
+
+        Vector<char> buf;
+        ParallelDescriptor::ReadAndBcastFile(FullPath + "/" + delta_header_name, buf);
+        std::istringstream is(buf.dataPtr(), std::istringstream::in);
+
+        std::string version, base, name;
+        int nchain, ndesc;
+        is >> version >> base >> nchain;
+        for (int j = 0; j < nchain; j++)
+            is >> name;
+        is >> ndesc;
+
+        if (ndesc != AmrLevel::get_desc_lst().size())
+            amrex::Abort("DeltaCheckpoint::replay(): number of state types changed");
+
+        for (int i = 0; i < ndesc; i++)
+        {
+            StateData& sd = lev.get_state_data(i);
+
+            for (int which = 0; which < 2; which++)
+            {
+                int n;
+                is >> n;
+                Vector<int> idx(n);
+                for (int j = 0; j < n; j++)
+                    is >> idx[j];
+
+                if (n == 0) continue;
+
+                if (which == 1 && !sd.hasOldData())
+                    amrex::Abort("DeltaCheckpoint::replay(): delta has old data but base does not");
+
+                MultiFab& mf = (which == 0) ? sd.newData() : sd.oldData();
+
+                const BoxArray&            ba = mf.boxArray();
+                const DistributionMapping& dm = mf.DistributionMap();
+
+                BoxList     bl(ba.ixType());
+                Vector<int> pmap(n);
+                for (int j = 0; j < n; j++)
+                {
+                    bl.push_back(ba[idx[j]]);
+                    pmap[j] = dm[idx[j]];
+                }
+
+                MultiFab delta(BoxArray(bl), DistributionMapping(pmap), mf.nComp(), mf.nGrow());
+
+                const std::string suffix = (which == 0) ? "_Delta_New" : "_Delta_Old";
+                VisMF::Read(delta, sdName(FullPath, i) + suffix);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+                for (MFIter mfi(delta); mfi.isValid(); ++mfi)
+                {
+                    mf[idx[mfi.index()]].copy(delta[mfi]);
+                }
+            }
+        }
+    }
+}
@@ -8,11 +8,14 @@
 #include <AMReX_CGSolver.H>
 
 #include <DIFFUSION_F.H>
+#include <SolverStats.H>
 
 #include <algorithm>
 #include <cfloat>
+#include <cmath>
 #include <iomanip>
 #include <array>
+#include <utility>
 
 #include <AMReX_MLABecLaplacian.H>
 #include <AMReX_MLMG.H>
@@ -49,6 +52,7 @@ namespace
     static int max_fmg_iter = 0;
     static int use_hypre = 0;
     static int hypre_verbose = 0;
+    static Real sts_max_dnum = 0;
 }
 //
 // Set default values in !initialized section of code in constructor!!!
@@ -126,6 +130,7 @@ Diffusion::Diffusion (Amr*               Parent,
         ppdiff.query("agglomeration", agglomeration);
         ppdiff.query("consolidation", consolidation);
         ppdiff.query("max_fmg_iter", max_fmg_iter);
+        ppdiff.query("sts_max_dnum", sts_max_dnum);
 #ifdef AMREX_USE_HYPRE
         ppdiff.query("use_hypre", use_hypre);
         ppdiff.query("hypre_verbose", hypre_verbose);
@@ -253,7 +258,8 @@ Diffusion::diffuse_scalar (Real                   dt,
                            const MultiFab* const* betanp1,
                            int                    betaComp,
                            const SolveMode&       solve_mode,
-                           bool                   add_old_time_divFlux)
+                           bool                   add_old_time_divFlux,
+                           int                    nstages)
 {
     //
     // This routine expects that physical BC's have been loaded into
@@ -264,9 +270,6 @@ Diffusion::diffuse_scalar (Real                   dt,
     // on the valid region (i.e., on the valid region the new state is the old
     // state + dt*Div(explicit_fluxes), e.g.)
     //
-
-    const MultiFab& volume = navier_stokes->Volume();
-    
     if (verbose)
       amrex::Print() << "... Diffusion::diffuse_scalar(): " 
                      << navier_stokes->get_desc_lst()[State_Type].name(sigma) 
@@ -279,16 +282,296 @@ Diffusion::diffuse_scalar (Real                   dt,
     checkBeta(betanp1, allthere, allnull);
 
     BL_ASSERT(solve_mode==ONEPASS || (delta_rhs && delta_rhs->boxArray()==grids));
+
+    if (allnull && alpha == 0 && solve_mode == ONEPASS && add_old_time_divFlux)
+    {
+        if (nstages < 0)
+            nstages = stsStages(sigma,dt,rho_half,rho_flag);
+
+        if (nstages > 0)
+        {
+            diffuse_scalar_sts(dt,sigma,rho_half,rho_flag,fluxn,fluxnp1,fluxComp,
+                               delta_rhs,rhsComp,nstages);
+            return;
+        }
+    }
+
+    MultiFab Rhs(grids,dmap,1,0),Soln(grids,dmap,1,1);
+    MemoryAccount::Tag work_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(Rhs) + MemoryAccount::bytes(Soln));
+
+    scalarRhs(dt,sigma,be_cn_theta,rho_half,rho_flag,allnull,fluxn,fluxComp,
+              delta_rhs,rhsComp,alpha,alphaComp,betan,betaComp,solve_mode,
+              add_old_time_divFlux,Rhs,Soln);
     //
-    // At this point, S_old has bndry at time N, S_new has bndry at time N+1
+    // Construct viscous operator with bndry data at time N+1.
     //
-    MultiFab& S_old = navier_stokes->get_old_data(State_Type);
-    MultiFab& S_new = navier_stokes->get_new_data(State_Type);
+    Real a = 1.0;
+    Real b = be_cn_theta*dt;
+    if (allnull) {
+        b *= visc_coef[sigma];
+    }
+
+    const Real cur_time = navier_stokes->get_state_data(State_Type).curTime();
+    Real       rhsscale = 1.0;
+
+    if (use_mlmg_solver)
+    {
+        const Real strt_time = ParallelDescriptor::second();
+
+        LPInfo info;
+        info.setAgglomeration(agglomeration);
+        info.setConsolidation(consolidation);
+        info.setMetricTerm(false);
+
+        MLABecLaplacian mlabec({navier_stokes->Geom()}, {grids}, {dmap}, info);
+
+        scalarOp(mlabec,sigma,a,b,cur_time,rho_half,rho_flag,&rhsscale,
+                 betanp1,betaComp,alpha,alphaComp);
+        setScalarLevelBC(mlabec,sigma,rho_flag,cur_time);
+
+        MLMG mlmg(mlabec);
+        if (use_hypre) {
+            mlmg.setBottomSolver(MLMG::BottomSolver::hypre);
+            mlmg.setBottomVerbose(hypre_verbose);
+        }
+        mlmg.setMaxFmgIter(max_fmg_iter);
+        mlmg.setVerbose(verbose);
+
+        Rhs.mult(rhsscale,0,1);
+        const Real S_tol     = visc_tol;
+        const Real S_tol_abs = get_scaled_abs_tol(Rhs, visc_tol);
+
+        const Real solve_time = ParallelDescriptor::second();
+
+        mlmg.solve({&Soln}, {&Rhs}, S_tol, S_tol_abs);
+
+        SolverStats::add("diffuse_scalar", level, mlmg, solve_time - strt_time,
+                         ParallelDescriptor::second() - solve_time);
+
+        AMREX_D_TERM(MultiFab flxx(*fluxnp1[0], amrex::make_alias, fluxComp, 1);,
+                     MultiFab flxy(*fluxnp1[1], amrex::make_alias, fluxComp, 1);,
+                     MultiFab flxz(*fluxnp1[2], amrex::make_alias, fluxComp, 1););
+        std::array<MultiFab*,AMREX_SPACEDIM> fp{AMREX_D_DECL(&flxx,&flxy,&flxz)};
+        mlmg.getFluxes({fp});
+    }
+    else
+    {
+        ViscBndry  visc_bndry;
+        std::unique_ptr<ABecLaplacian> visc_op
+            (getViscOp(sigma,a,b,cur_time,visc_bndry,rho_half,
+                       rho_flag,&rhsscale,betanp1,betaComp,alpha,alphaComp));
+        Rhs.mult(rhsscale,0,1);
+        visc_op->maxOrder(max_order);
+
+        //
+        // Construct solver and call it.
+        //
+        const Real S_tol     = visc_tol;
+        const Real S_tol_abs = get_scaled_abs_tol(Rhs, visc_tol);
+        
+        MultiGrid mg(*visc_op);
+        mg.solve(Soln,Rhs,S_tol,S_tol_abs);
+
+        //
+        // Get extensivefluxes from new-time op
+        //
+        bool do_applyBC = true;
+        visc_op->compFlux(D_DECL(*fluxnp1[0],*fluxnp1[1],*fluxnp1[2]),Soln,do_applyBC,LinOp::Inhomogeneous_BC,0,fluxComp);
+    }
+
+    scalarSoln(dt,sigma,b,rho_flag,fluxnp1,fluxComp,Soln);
+
+    if (verbose)
+    {
+        const int IOProc   = ParallelDescriptor::IOProcessorNumber();
+        Real      run_time = ParallelDescriptor::second() - strt_time;
+
+        ParallelDescriptor::ReduceRealMax(run_time,IOProc);
 
+	amrex::Print() << "Diffusion::diffuse_scalar(): lev: " << level
+		       << ", time: " << run_time << '\n';
+    }
+}
+
+void
+Diffusion::diffuse_scalars (Real               dt,
+                            const Vector<int>& sigmas,
+                            Real               be_cn_theta,
+                            const MultiFab&    rho_half,
+                            int                rho_flag,
+                            MultiFab* const*   fluxn,
+                            MultiFab* const*   fluxnp1,
+                            int                fluxComp)
+{
+    const int nscal = sigmas.size();
+    //
+    // The scalars share visc_coef and rho_flag, and so the stage count.
+    //
+    const int nstages = stsStages(sigmas[0],dt,rho_half,rho_flag);
+
+    if (!use_mlmg_solver || nscal == 1 || nstages > 0)
+    {
+        for (int i = 0; i < nscal; i++)
+        {
+            diffuse_scalar(dt,sigmas[i],be_cn_theta,rho_half,rho_flag,
+                           fluxn,fluxnp1,fluxComp+i,0,0,0,0,0,0,0,ONEPASS,true,nstages);
+        }
+        return;
+    }
+
+    if (verbose)
+    {
+        amrex::Print() << "... Diffusion::diffuse_scalars():";
+        for (int i = 0; i < nscal; i++)
+            amrex::Print() << ' ' << navier_stokes->get_desc_lst()[State_Type].name(sigmas[i]);
+        amrex::Print() << " lev: " << level << '\n';
+    }
+
+    const Real strt_time = ParallelDescriptor::second();
     //
-    // Set up Rhs.
+    // The scalars share visc_coef, rho_flag and the domain BCs, so the
+    // operator, its coefficients and the solver built for the first one
+    // serve them all; only the coarse/fine and physical boundary values
+    // are reset between the solves.  The solves themselves are still one
+    // per scalar.
     //
+    const Real a        = 1.0;
+    const Real b        = be_cn_theta*dt*visc_coef[sigmas[0]];
+    const Real cur_time = navier_stokes->get_state_data(State_Type).curTime();
+    Real       rhsscale = 1.0;
+
+    LPInfo info;
+    info.setAgglomeration(agglomeration);
+    info.setConsolidation(consolidation);
+    info.setMetricTerm(false);
+
+    MLABecLaplacian mlabec({navier_stokes->Geom()}, {grids}, {dmap}, info);
+
+    scalarOp(mlabec,sigmas[0],a,b,cur_time,rho_half,rho_flag,&rhsscale,0,0,0,0);
+
+    MLMG mlmg(mlabec);
+    if (use_hypre) {
+        mlmg.setBottomSolver(MLMG::BottomSolver::hypre);
+        mlmg.setBottomVerbose(hypre_verbose);
+    }
+    mlmg.setMaxFmgIter(max_fmg_iter);
+    mlmg.setVerbose(verbose);
+
+    Real setup_time = ParallelDescriptor::second() - strt_time;
+
     MultiFab Rhs(grids,dmap,1,0),Soln(grids,dmap,1,1);
+    MemoryAccount::Tag work_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(Rhs) + MemoryAccount::bytes(Soln));
+
+    for (int i = 0; i < nscal; i++)
+    {
+        const int sigma = sigmas[i];
+
+        scalarRhs(dt,sigma,be_cn_theta,rho_half,rho_flag,1,fluxn,fluxComp+i,
+                  0,0,0,0,0,0,ONEPASS,true,Rhs,Soln);
+
+        const Real bc_time = ParallelDescriptor::second();
+
+        setScalarLevelBC(mlabec,sigma,rho_flag,cur_time);
+
+        Rhs.mult(rhsscale,0,1);
+        const Real S_tol     = visc_tol;
+        const Real S_tol_abs = get_scaled_abs_tol(Rhs, visc_tol);
+
+        const Real solve_time = ParallelDescriptor::second();
+
+        mlmg.solve({&Soln}, {&Rhs}, S_tol, S_tol_abs);
+
+        SolverStats::add("diffuse_scalar", level, mlmg, setup_time + solve_time - bc_time,
+                         ParallelDescriptor::second() - solve_time);
+        setup_time = 0;
+
+        AMREX_D_TERM(MultiFab flxx(*fluxnp1[0], amrex::make_alias, fluxComp+i, 1);,
+                     MultiFab flxy(*fluxnp1[1], amrex::make_alias, fluxComp+i, 1);,
+                     MultiFab flxz(*fluxnp1[2], amrex::make_alias, fluxComp+i, 1););
+        std::array<MultiFab*,AMREX_SPACEDIM> fp{AMREX_D_DECL(&flxx,&flxy,&flxz)};
+        mlmg.getFluxes({fp});
+
+        scalarSoln(dt,sigma,b,rho_flag,fluxnp1,fluxComp+i,Soln);
+    }
+
+    if (verbose)
+    {
+        const int IOProc   = ParallelDescriptor::IOProcessorNumber();
+        Real      run_time = ParallelDescriptor::second() - strt_time;
+
+        ParallelDescriptor::ReduceRealMax(run_time,IOProc);
+
+	amrex::Print() << "Diffusion::diffuse_scalars(): lev: " << level
+		       << ", time: " << run_time << '\n';
+    }
+}
+
+void
+Diffusion::groupScalars (const Vector<int>&     comps,
+                         const Vector<int>&     rho_flags,
+                         Vector< Vector<int> >& groups)
+{
+    groups.clear();
+
+    Vector<int> lead;   // index in comps of the first member of each group
+
+    for (int i = 0; i < comps.size(); i++)
+    {
+        const int comp = comps[i];
+
+        std::array<LinOpBCType,AMREX_SPACEDIM> lobc, hibc;
+        setDomainBC(lobc, hibc, comp);
+
+        int g = 0;
+        for ( ; g < groups.size(); g++)
+        {
+            const int l = lead[g];
+
+            std::array<LinOpBCType,AMREX_SPACEDIM> globc, ghibc;
+            setDomainBC(globc, ghibc, comps[l]);
+
+            if (visc_coef[comps[l]] == visc_coef[comp] && rho_flags[l] == rho_flags[i] &&
+                globc == lobc && ghibc == hibc)
+                break;
+        }
+
+        if (g == groups.size())
+        {
+            groups.push_back(Vector<int>());
+            lead.push_back(i);
+        }
+        groups[g].push_back(comp);
+    }
+}
+
+void
+Diffusion::scalarRhs (Real                   dt,
+                      int                    sigma,
+                      Real                   be_cn_theta,
+                      const MultiFab&        rho_half,
+                      int                    rho_flag,
+                      int                    allnull,
+                      MultiFab* const*       fluxn,
+                      int                    fluxComp,
+                      MultiFab*              delta_rhs, 
+                      int                    rhsComp,
+                      const MultiFab*        alpha, 
+                      int                    alphaComp,
+                      const MultiFab* const* betan, 
+                      int                    betaComp,
+                      const SolveMode&       solve_mode,
+                      bool                   add_old_time_divFlux,
+                      MultiFab&              Rhs,
+                      MultiFab&              Soln)
+{
+    const MultiFab& volume = navier_stokes->Volume();
+    //
+    // At this point, S_old has bndry at time N, S_new has bndry at time N+1
+    //
+    MultiFab& S_old = navier_stokes->get_old_data(State_Type);
+    MultiFab& S_new = navier_stokes->get_new_data(State_Type);
 
     if (add_old_time_divFlux)
     {
@@ -454,129 +737,338 @@ Diffusion::diffuse_scalar (Real                   dt,
             Soln[Smfi].divide(S_new[Smfi],Smfi.tilebox(),Density,0,1);
         }
     }
+}
+
+void
+Diffusion::scalarOp (MLABecLaplacian&       mlabec,
+                     int                    comp,
+                     Real                   a,
+                     Real                   b,
+                     Real                   time,
+                     const MultiFab&        rho_half,
+                     int                    rho_flag,
+                     Real*                  rhsscale,
+                     const MultiFab* const* beta,
+                     int                    betaComp,
+                     const MultiFab*        alpha,
+                     int                    alphaComp)
+{
+    mlabec.setMaxOrder(max_order);
+
+    std::array<LinOpBCType,AMREX_SPACEDIM> mlmg_lobc;
+    std::array<LinOpBCType,AMREX_SPACEDIM> mlmg_hibc;
+    setDomainBC(mlmg_lobc, mlmg_hibc, comp);
+
+    mlabec.setDomainBC(mlmg_lobc, mlmg_hibc);
+
+    {
+        MultiFab acoef;
+        std::pair<Real,Real> scalars;
+        computeAlpha(acoef, scalars, comp, a, b, time, rho_half, rho_flag,
+                     rhsscale, alphaComp, alpha);
+        mlabec.setScalars(scalars.first, scalars.second);
+        mlabec.setACoeffs(0, acoef);
+    }
+
+    {
+        std::array<MultiFab,BL_SPACEDIM> bcoeffs;
+        computeBeta(bcoeffs, beta, betaComp);
+        mlabec.setBCoeffs(0, amrex::GetArrOfConstPtrs(bcoeffs));
+    }
+}
+
+void
+Diffusion::setScalarLevelBC (MLABecLaplacian& mlabec,
+                             int              sigma,
+                             int              rho_flag,
+                             Real             time)
+{
+    const int ng = 1;
+    MultiFab crsedata;
+    if (level > 0) {
+        auto& crse_ns = *(coarser->navier_stokes);
+        crsedata.define(crse_ns.boxArray(), crse_ns.DistributionMap(), 1, ng);
+        AmrLevel::FillPatch(crse_ns,crsedata,ng,time,State_Type,sigma,1);
+        if (rho_flag == 2) {
+            const MultiFab& rhotime = crse_ns.get_rho(time);
+            MultiFab::Divide(crsedata,rhotime,0,0,1,1);
+        }
+        mlabec.setCoarseFineBC(&crsedata, crse_ratio[0]);
+    }
+    MultiFab S(grids,dmap,1,ng);
+    AmrLevel::FillPatch(*navier_stokes,S,ng,time,State_Type,sigma,1);
+    if (rho_flag == 2) {
+        const MultiFab& rhotime = navier_stokes->get_rho(time);
+        MultiFab::Divide(S,rhotime,0,0,1,1);
+    }
+    mlabec.setLevelBC(0, &S);
+}
+
+void
+Diffusion::scalarSoln (Real             dt,
+                       int              sigma,
+                       Real             b,
+                       int              rho_flag,
+                       MultiFab* const* fluxnp1,
+                       int              fluxComp,
+                       const MultiFab&  Soln)
+{
+    MultiFab& S_new = navier_stokes->get_new_data(State_Type);
+
+    for (int i = 0; i < BL_SPACEDIM; ++i)
+        (*fluxnp1[i]).mult(b/(dt*navier_stokes->Geom().CellSize()[i]),fluxComp,1,0);
     //
-    // Construct viscous operator with bndry data at time N+1.
+    // Copy into state variable at new time, without bc's
     //
-    Real a = 1.0;
-    Real b = be_cn_theta*dt;
-    if (allnull) {
-        b *= visc_coef[sigma];
+    MultiFab::Copy(S_new,Soln,0,sigma,1,0);
+    
+    if (rho_flag == 2) {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter Smfi(S_new,true); Smfi.isValid(); ++Smfi) {
+            S_new[Smfi].mult(S_new[Smfi],Smfi.tilebox(),Density,sigma,1);
+	}
     }
+}
 
-    const Real cur_time = navier_stokes->get_state_data(State_Type).curTime();
-    Real       rhsscale = 1.0;
+int
+Diffusion::stsStages (int             sigma,
+                      Real            dt,
+                      const MultiFab& rho_half,
+                      int             rho_flag)
+{
+    if (sts_max_dnum <= 0 || parent->Geom(0).IsRZ() || (rho_flag != 0 && rho_flag != 1))
+        return 0;
+    //
+    // The diffusivity of the scalar, and its diffusion number on this level.
+    //
+    Real D = visc_coef[sigma];
+    if (rho_flag == 1)
+        D /= rho_half.min(0);
 
-    if (use_mlmg_solver)
+    if (D <= 0)
+        return 0;
+
+    const Real* dx    = navier_stokes->Geom().CellSize();
+    Real        dxmin = dx[0];
+    Real        sumdx = 0;
+    for (int d = 0; d < BL_SPACEDIM; d++)
     {
-        LPInfo info;
-        info.setAgglomeration(agglomeration);
-        info.setConsolidation(consolidation);
-        info.setMetricTerm(false);
+        dxmin  = std::min(dxmin, dx[d]);
+        sumdx += 1.0/(dx[d]*dx[d]);
+    }
 
-        MLABecLaplacian mlabec({navier_stokes->Geom()}, {grids}, {dmap}, info);
-        mlabec.setMaxOrder(max_order);
+    const Real dnum = D*dt/(dxmin*dxmin);
 
-        std::array<LinOpBCType,AMREX_SPACEDIM> mlmg_lobc;
-        std::array<LinOpBCType,AMREX_SPACEDIM> mlmg_hibc;
-        setDomainBC(mlmg_lobc, mlmg_hibc, sigma);
-        
-        mlabec.setDomainBC(mlmg_lobc, mlmg_hibc);
+    if (dnum > sts_max_dnum)
+        return 0;
+    //
+    // RKL2 with s stages is stable up to (s*s+s-2)/4 times the forward
+    // Euler limit 1/(2 D sum 1/dx^2); take one stage more, and an odd count.
+    //
+    const Real ratio = 2.0*D*dt*sumdx;
+    int        s     = int(0.5*(std::sqrt(9.0 + 16.0*ratio) - 1.0)) + 1;
+    if (s % 2 == 0)
+        s++;
+
+    if (verbose)
+        amrex::Print() << "... Diffusion: " << navier_stokes->get_desc_lst()[State_Type].name(sigma)
+                       << " lev: " << level << " diffusion number " << dnum
+                       << ", RKL2 with " << s << " stages\n";
+
+    return s;
+}
+
+void
+Diffusion::diffuse_scalar_sts (Real             dt,
+                               int              sigma,
+                               const MultiFab&  rho_half,
+                               int              rho_flag,
+                               MultiFab* const* fluxn,
+                               MultiFab* const* fluxnp1,
+                               int              fluxComp,
+                               const MultiFab*  delta_rhs,
+                               int              rhsComp,
+                               int              nstages)
+{
+    //
+    // Integrate A dS/dt = -Div(F(S)) + A R over the step with the second
+    // order Runge-Kutta-Legendre super-time-stepping scheme (RKL2; Meyer,
+    // Balsara and Aslam, J. Comput. Phys. 257, 2014), where A is the volume,
+    // times rho_half if rho_flag==1, F the extensive diffusive flux, and R
+    // the explicit increment, already in S_new, divided by dt plus delta_rhs.
+    // Every stage is one flux evaluation with the boundary values at the
+    // stage time; the stage fluxes are combined like the stages, so that
+    // the returned flux is consistent with the update for refluxing.
+    //
+    const Real strt_time = ParallelDescriptor::second();
+
+    MultiFab&   S_old     = navier_stokes->get_old_data(State_Type);
+    MultiFab&   S_new     = navier_stokes->get_new_data(State_Type);
+    const Real  prev_time = navier_stokes->get_state_data(State_Type).prevTime();
+    const Real  cur_time  = navier_stokes->get_state_data(State_Type).curTime();
+    const Real* dx        = navier_stokes->Geom().CellSize();
+
+    MultiFab acoef;
+    {
+        std::pair<Real,Real> scalars;
+        computeAlpha(acoef, scalars, sigma, 1.0, 0.0, cur_time, rho_half, rho_flag,
+                     0, 0, 0);
+    }
+
+    MultiFab rate(grids,dmap,1,0);
+    MemoryAccount::Tag work_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(rate));
+    MultiFab::LinComb(rate,1.0/dt,S_new,sigma,-1.0/dt,S_old,sigma,0,1,0);
+    if (delta_rhs != 0)
+    {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        FArrayBox tmpfab;
+        for (MFIter mfi(rate,true); mfi.isValid(); ++mfi)
         {
-            const int ng = 1;
-            MultiFab crsedata;
-            if (level > 0) {
-                auto& crse_ns = *(coarser->navier_stokes);
-                crsedata.define(crse_ns.boxArray(), crse_ns.DistributionMap(), 1, ng);
-                AmrLevel::FillPatch(crse_ns,crsedata,ng,cur_time,State_Type,sigma,1);
-                if (rho_flag == 2) {
-                    const MultiFab& rhotime = crse_ns.get_rho(cur_time);
-                    MultiFab::Divide(crsedata,rhotime,0,0,1,1);
-                }
-                mlabec.setCoarseFineBC(&crsedata, crse_ratio[0]);
-            }
-            MultiFab S(grids,dmap,1,ng);
-            AmrLevel::FillPatch(*navier_stokes,S,ng,cur_time,State_Type,sigma,1);
-            if (rho_flag == 2) {
-                const MultiFab& rhotime = navier_stokes->get_rho(cur_time);
-                MultiFab::Divide(S,rhotime,0,0,1,1);
-            }
-            mlabec.setLevelBC(0, &S);
+            const Box& box = mfi.tilebox();
+            tmpfab.resize(box,1);
+            tmpfab.copy((*delta_rhs)[mfi],box,rhsComp,box,0,1);
+            if (rho_flag == 1)
+                tmpfab.divide(rho_half[mfi],box,0,0,1);
+            rate[mfi].plus(tmpfab,box,0,0,1);
         }
+    }
+    }
+    //
+    // The operator and its coefficients do not change over the step; it is
+    // built once, and only the boundary values it reads are reset to the
+    // stage time before every flux evaluation.
+    //
+    ViscBndry visc_bndry;
+    std::unique_ptr<ABecLaplacian> visc_op
+        (getViscOp(sigma,0.0,visc_coef[sigma],prev_time,visc_bndry,rho_half,rho_flag,0,0,0,0,0));
 
+    Real bndry_time = prev_time;
+    //
+    // The flux F(Y) and the rate M(Y) = (-Div(F) + A R)/A of the state Y at time.
+    //
+    auto eval = [&] (MultiFab& Y, Real time, std::array<MultiFab,BL_SPACEDIM>& F, MultiFab& M)
+    {
+        if (time != bndry_time)
         {
-            MultiFab acoef;
-            std::pair<Real,Real> scalars;
-            computeAlpha(acoef, scalars, sigma, a, b, cur_time, rho_half, rho_flag,
-                         &rhsscale, alphaComp, alpha);
-            mlabec.setScalars(scalars.first, scalars.second);
-            mlabec.setACoeffs(0, acoef);
+            setBndryData(visc_bndry,sigma,1,time,rho_flag);
+            bndry_time = time;
         }
-        
+
+        visc_op->compFlux(D_DECL(F[0],F[1],F[2]),Y,true,LinOp::Inhomogeneous_BC,0,0);
+
+        for (int d = 0; d < BL_SPACEDIM; d++)
+            F[d].mult(visc_coef[sigma]/dx[d],0,1,0);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(M,true); mfi.isValid(); ++mfi)
         {
-            std::array<MultiFab,BL_SPACEDIM> bcoeffs;
-            computeBeta(bcoeffs, betanp1, betaComp);
-            mlabec.setBCoeffs(0, amrex::GetArrOfConstPtrs(bcoeffs));
+            const Box& bx = mfi.tilebox();
+            auto       m  = M.array(mfi);
+            const auto a  = acoef.array(mfi);
+            const auto r  = rate.array(mfi);
+            AMREX_D_TERM(const auto fx = F[0].array(mfi);,
+                         const auto fy = F[1].array(mfi);,
+                         const auto fz = F[2].array(mfi););
+
+            AMREX_HOST_DEVICE_FOR_3D ( bx, i, j, k,
+            {
+                m(i,j,k) = r(i,j,k) - (AMREX_D_TERM(fx(i+1,j,k) - fx(i,j,k),
+                                                    + fy(i,j+1,k) - fy(i,j,k),
+                                                    + fz(i,j,k+1) - fz(i,j,k))) / a(i,j,k);
+            });
         }
+    };
 
-        MLMG mlmg(mlabec);
-        if (use_hypre) {
-            mlmg.setBottomSolver(MLMG::BottomSolver::hypre);
-            mlmg.setBottomVerbose(hypre_verbose);
-        }
-        mlmg.setMaxFmgIter(max_fmg_iter);
-        mlmg.setVerbose(verbose);
+    auto define_fluxes = [&] (std::array<MultiFab,BL_SPACEDIM>& F)
+    {
+        for (int d = 0; d < BL_SPACEDIM; d++)
+            F[d].define(navier_stokes->getEdgeBoxArray(d),dmap,1,0);
+    };
+    //
+    // The RKL2 weights.
+    //
+    auto bj = [] (int j) -> Real { return (j < 2) ? 1.0/3.0 : (j*j+j-2.0)/(2.0*j*(j+1.0)); };
 
-        Rhs.mult(rhsscale,0,1);
-        const Real S_tol     = visc_tol;
-        const Real S_tol_abs = get_scaled_abs_tol(Rhs, visc_tol);
+    const int  s  = nstages;
+    const Real w1 = 4.0/(s*s+s-2.0);
 
-        mlmg.solve({&Soln}, {&Rhs}, S_tol, S_tol_abs);
+    MultiFab Y0(grids,dmap,1,1), Yjm1(grids,dmap,1,1), Yjm2(grids,dmap,1,1), Yj(grids,dmap,1,1);
+    MultiFab M0(grids,dmap,1,0), Mj(grids,dmap,1,0);
 
-        AMREX_D_TERM(MultiFab flxx(*fluxnp1[0], amrex::make_alias, fluxComp, 1);,
-                     MultiFab flxy(*fluxnp1[1], amrex::make_alias, fluxComp, 1);,
-                     MultiFab flxz(*fluxnp1[2], amrex::make_alias, fluxComp, 1););
-        std::array<MultiFab*,AMREX_SPACEDIM> fp{AMREX_D_DECL(&flxx,&flxy,&flxz)};
-        mlmg.getFluxes({fp});
+    std::array<MultiFab,BL_SPACEDIM> G0, Gj, Fjm1, Fjm2, Fj;
+    define_fluxes(G0);
+    define_fluxes(Gj);
+    define_fluxes(Fjm1);
+    define_fluxes(Fjm2);
+    define_fluxes(Fj);
+
+    MultiFab::Copy(Y0,S_old,sigma,0,1,0);
+
+    eval(Y0, prev_time, G0, M0);
+    //
+    // The first stage; cj is the time of stage j in units of dt.
+    //
+    const Real mt1 = bj(1)*w1;
+
+    MultiFab::LinComb(Yjm1,1.0,Y0,0,mt1*dt,M0,0,0,1,0);
+    MultiFab::Copy(Yjm2,Y0,0,0,1,0);
+    for (int d = 0; d < BL_SPACEDIM; d++)
+    {
+        MultiFab::Copy(Fjm1[d],G0[d],0,0,1,0);
+        Fjm1[d].mult(mt1*dt,0,1,0);
+        Fjm2[d].setVal(0);
     }
-    else
+
+    Real cjm1 = mt1, cjm2 = 0;
+
+    for (int j = 2; j <= s; j++)
     {
-        ViscBndry  visc_bndry;
-        std::unique_ptr<ABecLaplacian> visc_op
-            (getViscOp(sigma,a,b,cur_time,visc_bndry,rho_half,
-                       rho_flag,&rhsscale,betanp1,betaComp,alpha,alphaComp));
-        Rhs.mult(rhsscale,0,1);
-        visc_op->maxOrder(max_order);
+        eval(Yjm1, prev_time + cjm1*dt, Gj, Mj);
 
-        //
-        // Construct solver and call it.
-        //
-        const Real S_tol     = visc_tol;
-        const Real S_tol_abs = get_scaled_abs_tol(Rhs, visc_tol);
-        
-        MultiGrid mg(*visc_op);
-        mg.solve(Soln,Rhs,S_tol,S_tol_abs);
+        const Real mu  = (2.0*j-1.0)/j * bj(j)/bj(j-1);
+        const Real nu  = -(j-1.0)/j * bj(j)/bj(j-2);
+        const Real mt  = mu*w1;
+        const Real gt  = -(1.0-bj(j-1))*mt;
 
-        //
-        // Get extensivefluxes from new-time op
-        //
-        bool do_applyBC = true;
-        visc_op->compFlux(D_DECL(*fluxnp1[0],*fluxnp1[1],*fluxnp1[2]),Soln,do_applyBC,LinOp::Inhomogeneous_BC,0,fluxComp);
-    }
+        MultiFab::LinComb(Yj,mu,Yjm1,0,nu,Yjm2,0,0,1,0);
+        MultiFab::Saxpy(Yj,1.0-mu-nu,Y0,0,0,1,0);
+        MultiFab::Saxpy(Yj,mt*dt,Mj,0,0,1,0);
+        MultiFab::Saxpy(Yj,gt*dt,M0,0,0,1,0);
 
-    for (int i = 0; i < BL_SPACEDIM; ++i)
-        (*fluxnp1[i]).mult(b/(dt*navier_stokes->Geom().CellSize()[i]),fluxComp,1,0);
+        for (int d = 0; d < BL_SPACEDIM; d++)
+        {
+            MultiFab::LinComb(Fj[d],mu,Fjm1[d],0,nu,Fjm2[d],0,0,1,0);
+            MultiFab::Saxpy(Fj[d],mt*dt,Gj[d],0,0,1,0);
+            MultiFab::Saxpy(Fj[d],gt*dt,G0[d],0,0,1,0);
+        }
+
+        const Real cj = mu*cjm1 + nu*cjm2 + mt + gt;
+
+        std::swap(Yjm2,Yjm1);
+        std::swap(Yjm1,Yj);
+        std::swap(Fjm2,Fjm1);
+        std::swap(Fjm1,Fj);
+        cjm2 = cjm1;
+        cjm1 = cj;
+    }
     //
-    // Copy into state variable at new time, without bc's
+    // Yjm1 is the new state, and Fjm1 the flux integrated over the step.
     //
-    MultiFab::Copy(S_new,Soln,0,sigma,1,0);
-    
-    if (rho_flag == 2) {
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-    for (MFIter Smfi(S_new,true); Smfi.isValid(); ++Smfi) {
-            S_new[Smfi].mult(S_new[Smfi],Smfi.tilebox(),Density,sigma,1);
-	}
+    MultiFab::Copy(S_new,Yjm1,0,sigma,1,0);
+
+    for (int d = 0; d < BL_SPACEDIM; d++)
+    {
+        fluxn[d]->setVal(0,fluxComp,1,0);
+        MultiFab::Copy(*fluxnp1[d],Fjm1[d],0,fluxComp,1,0);
+        fluxnp1[d]->mult(1.0/dt,fluxComp,1,0);
     }
 
     if (verbose)
@@ -586,7 +1078,7 @@ Diffusion::diffuse_scalar (Real                   dt,
 
         ParallelDescriptor::ReduceRealMax(run_time,IOProc);
 
-	amrex::Print() << "Diffusion::diffuse_scalar(): lev: " << level
+	amrex::Print() << "Diffusion::diffuse_scalar_sts(): lev: " << level
 		       << ", time: " << run_time << '\n';
     }
 }
@@ -631,8 +1123,8 @@ Diffusion::diffuse_velocity (Real                   dt,
 
     if (allnull)
     {
-	FluxBoxes fb_SCn  (navier_stokes);
-	FluxBoxes fb_SCnp1(navier_stokes);
+	FluxBoxes fb_SCn  (navier_stokes, NavierStokesBase::theMemoryAccount());
+	FluxBoxes fb_SCnp1(navier_stokes, NavierStokesBase::theMemoryAccount());
 
         MultiFab* *fluxSCn   = fb_SCn.get();
         MultiFab* *fluxSCnp1 = fb_SCnp1.get();
@@ -675,7 +1167,7 @@ Diffusion::diffuse_velocity (Real                   dt,
         if (level < parent->finestLevel())
         {
             for (int d = 0; d < BL_SPACEDIM; ++d)
-                finer->viscflux_reg->CrseInit(fluxes[d],d,0,0,BL_SPACEDIM,-dt);
+                navier_stokes->stageCrseFlux(NavierStokesBase::ViscFluxReg,fluxes[d],d,0,0,BL_SPACEDIM,-dt);
         }
     }
     else
@@ -725,6 +1217,8 @@ Diffusion::diffuse_tensor_velocity (Real                   dt,
     // This is part of the RHS for the viscous solve.
     //
     MultiFab Rhs(grids,dmap,BL_SPACEDIM,0);
+    MemoryAccount::Tag work_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(Rhs));
 
     MultiFab** tensorflux_old;
     FluxBoxes fb_old;
@@ -754,7 +1248,7 @@ Diffusion::diffuse_tensor_velocity (Real                   dt,
 	    
 	    if (do_reflux && (level<finest_level || level>0))
 	    {
-		tensorflux_old = fb_old.define(navier_stokes, BL_SPACEDIM);
+		tensorflux_old = fb_old.define(navier_stokes, NavierStokesBase::theMemoryAccount(), BL_SPACEDIM);
 		tensor_op->compFlux(D_DECL(*(tensorflux_old[0]),
 					   *(tensorflux_old[1]),
 					   *(tensorflux_old[2])),Soln_old);
@@ -863,6 +1357,8 @@ Diffusion::diffuse_tensor_velocity (Real                   dt,
     }
     const int soln_grow = 1;
     MultiFab Soln(grids,dmap,BL_SPACEDIM,soln_grow);
+    MemoryAccount::Tag soln_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(Soln));
     Soln.setVal(0);
     //
     // Compute guess of solution.
@@ -938,7 +1434,7 @@ Diffusion::diffuse_tensor_velocity (Real                   dt,
     //
     if (do_reflux && (level < finest_level || level > 0))
     {
-	FluxBoxes fb(navier_stokes, BL_SPACEDIM);
+	FluxBoxes fb(navier_stokes, NavierStokesBase::theMemoryAccount(), BL_SPACEDIM);
         MultiFab** tensorflux = fb.get();
         tensor_op->compFlux(D_DECL(*(tensorflux[0]), *(tensorflux[1]), *(tensorflux[2])),Soln);
 
@@ -957,7 +1453,7 @@ Diffusion::diffuse_tensor_velocity (Real                   dt,
         if (level < finest_level)
         {
             for (int d = 0; d < BL_SPACEDIM; d++)
-                finer->viscflux_reg->CrseInit(*tensorflux[d],d,0,Xvel,BL_SPACEDIM,-dt);
+                navier_stokes->stageCrseFlux(NavierStokesBase::ViscFluxReg,*tensorflux[d],d,0,Xvel,BL_SPACEDIM,-dt);
         }
     }
 }
@@ -1035,6 +1531,8 @@ Diffusion::diffuse_Vsync_constant_mu (MultiFab&       Vsync,
     // so we loop over components.
     //
     MultiFab Rhs(grids,dmap,1,0);
+    MemoryAccount::Tag work_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(Rhs));
 
     for (int comp = 0; comp < BL_SPACEDIM; comp++)
     {
@@ -1066,6 +1564,8 @@ Diffusion::diffuse_Vsync_constant_mu (MultiFab&       Vsync,
         Real           rhsscale = 1.0;
 
         MultiFab Soln(grids,dmap,1,1);
+        MemoryAccount::Tag soln_tag(NavierStokesBase::theMemoryAccount(), level,
+                                    MemoryAccount::SolverWork, MemoryAccount::bytes(Soln));
         Soln.setVal(0);
 
         const Real S_tol     = visc_tol;
@@ -1073,6 +1573,8 @@ Diffusion::diffuse_Vsync_constant_mu (MultiFab&       Vsync,
         
         if (use_mlmg_solver)
         {
+            const Real strt_time = ParallelDescriptor::second();
+
             LPInfo info;
             info.setAgglomeration(agglomeration);
             info.setConsolidation(consolidation);
@@ -1118,7 +1620,13 @@ Diffusion::diffuse_Vsync_constant_mu (MultiFab&       Vsync,
             Rhs.mult(rhsscale,0,1);
 
             mlmg.setFinalFillBC(true);
+
+            const Real solve_time = ParallelDescriptor::second();
+
             mlmg.solve({&Soln}, {&Rhs}, S_tol, S_tol_abs);
+
+            SolverStats::add("diffuse_Vsync", level, mlmg, solve_time - strt_time,
+                             ParallelDescriptor::second() - solve_time);
         }
         else
         {
@@ -1252,6 +1760,8 @@ Diffusion::diffuse_tensor_Vsync (MultiFab&              Vsync,
     const MultiFab& volume = navier_stokes->Volume(); 
 
     MultiFab Rhs(grids,dmap,BL_SPACEDIM,0);
+    MemoryAccount::Tag work_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(Rhs));
 
     MultiFab::Copy(Rhs,Vsync,0,0,BL_SPACEDIM,0);
 
@@ -1293,6 +1803,8 @@ Diffusion::diffuse_tensor_Vsync (MultiFab&              Vsync,
     tensor_op->maxOrder(tensor_max_order);
 
     MultiFab Soln(grids,dmap,BL_SPACEDIM,1);
+    MemoryAccount::Tag soln_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(Soln));
 
     Soln.setVal(0);
     //
@@ -1325,7 +1837,7 @@ Diffusion::diffuse_tensor_Vsync (MultiFab&              Vsync,
 
     if (level > 0)
     {
-	FluxBoxes fb(navier_stokes, BL_SPACEDIM);
+	FluxBoxes fb(navier_stokes, NavierStokesBase::theMemoryAccount(), BL_SPACEDIM);
         MultiFab** tensorflux = fb.get();
         tensor_op->compFlux(D_DECL(*(tensorflux[0]), *(tensorflux[1]), *(tensorflux[2])),Soln);
         //
@@ -1405,10 +1917,14 @@ Diffusion::diffuse_Ssync (MultiFab&              Ssync,
     const Real S_tol_abs = -1;
 
     MultiFab Soln(grids,dmap,1,1);
+    MemoryAccount::Tag work_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(Soln));
     Soln.setVal(0);
 
     if (use_mlmg_solver)
     {
+        const Real strt_time = ParallelDescriptor::second();
+
         LPInfo info;
         info.setAgglomeration(agglomeration);
         info.setConsolidation(consolidation);
@@ -1464,7 +1980,12 @@ Diffusion::diffuse_Ssync (MultiFab&              Ssync,
             Rhs[Rhsmfi].mult(rhsscale,bx);
         }
 
+        const Real solve_time = ParallelDescriptor::second();
+
         mlmg.solve({&Soln}, {&Rhs}, S_tol, S_tol_abs);
+
+        SolverStats::add("diffuse_Ssync", level, mlmg, solve_time - strt_time,
+                         ParallelDescriptor::second() - solve_time);
         
         int flux_allthere, flux_allnull;
         checkBeta(flux, flux_allthere, flux_allnull);
@@ -1558,6 +2079,152 @@ Diffusion::diffuse_Ssync (MultiFab&              Ssync,
     }
 }
 
+void
+Diffusion::diffuse_Ssync (MultiFab&          Ssync,
+                          const Vector<int>& sigmas,
+                          Real               dt,
+                          Real               be_cn_theta,
+                          const MultiFab&    rho_half,
+                          int                rho_flag,
+                          MultiFab* const*   flux,
+                          int                fluxComp)
+{
+    const int nscal = sigmas.size();
+
+    if (!use_mlmg_solver || nscal == 1)
+    {
+        for (int i = 0; i < nscal; i++)
+        {
+            diffuse_Ssync(Ssync,sigmas[i],dt,be_cn_theta,rho_half,rho_flag,
+                          flux,fluxComp+i,0,0,0,0);
+        }
+        return;
+    }
+
+    const MultiFab& volume    = navier_stokes->Volume(); 
+    const int       state_ind = sigmas[0] + BL_SPACEDIM;
+
+    if (verbose)
+    {
+        amrex::Print() << "Diffusion::diffuse_Ssync lev: " << level;
+        for (int i = 0; i < nscal; i++)
+            amrex::Print() << ' ' << navier_stokes->get_desc_lst()[State_Type].name(sigmas[i]+BL_SPACEDIM);
+        amrex::Print() << '\n';
+    }
+
+    const Real strt_time = ParallelDescriptor::second();
+    //
+    // The sync problems are homogeneous and the scalars share visc_coef,
+    // rho_flag and the domain BCs, so one operator and solver serve them all,
+    // though each component is still solved on its own.
+    //
+    const Real a        = 1.0;
+    const Real b        = be_cn_theta*dt*visc_coef[state_ind];
+    const Real cur_time = navier_stokes->get_state_data(State_Type).curTime();
+    Real       rhsscale = 1.0;
+
+    LPInfo info;
+    info.setAgglomeration(agglomeration);
+    info.setConsolidation(consolidation);
+    info.setMetricTerm(false);
+
+    MLABecLaplacian mlabec({navier_stokes->Geom()}, {grids}, {dmap}, info);
+
+    scalarOp(mlabec,state_ind,a,b,cur_time,rho_half,rho_flag,&rhsscale,0,0,0,0);
+    if (level > 0) {
+        mlabec.setCoarseFineBC(nullptr, crse_ratio[0]);
+    }
+    mlabec.setLevelBC(0, nullptr);
+
+    MLMG mlmg(mlabec);
+    if (use_hypre) {
+        mlmg.setBottomSolver(MLMG::BottomSolver::hypre);
+        mlmg.setBottomVerbose(hypre_verbose);
+    }
+    mlmg.setMaxFmgIter(max_fmg_iter);
+    mlmg.setVerbose(verbose);
+
+    Real setup_time = ParallelDescriptor::second() - strt_time;
+
+    const Real S_tol     = visc_tol;
+    const Real S_tol_abs = -1;
+
+    int flux_allthere, flux_allnull;
+    checkBeta(flux, flux_allthere, flux_allnull);
+
+    MultiFab Rhs(grids,dmap,1,0),Soln(grids,dmap,1,1);
+    MemoryAccount::Tag work_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(Rhs) + MemoryAccount::bytes(Soln));
+
+    for (int i = 0; i < nscal; i++)
+    {
+        const int sigma = sigmas[i];
+
+        MultiFab::Copy(Rhs,Ssync,sigma,0,1,0);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter Rhsmfi(Rhs,true); Rhsmfi.isValid(); ++Rhsmfi)
+        {
+            const Box& bx = Rhsmfi.tilebox();
+            Rhs[Rhsmfi].mult(volume[Rhsmfi],bx,0,0); 
+            if (rho_flag == 1) {
+                Rhs[Rhsmfi].mult(rho_half[Rhsmfi],bx,0,0);
+            }
+            Rhs[Rhsmfi].mult(rhsscale,bx);
+        }
+
+        Soln.setVal(0);
+
+        const Real solve_time = ParallelDescriptor::second();
+
+        mlmg.solve({&Soln}, {&Rhs}, S_tol, S_tol_abs);
+
+        SolverStats::add("diffuse_Ssync", level, mlmg, setup_time,
+                         ParallelDescriptor::second() - solve_time);
+        setup_time = 0;
+
+        if (flux_allthere)
+        {
+            AMREX_D_TERM(MultiFab flxx(*flux[0], amrex::make_alias, fluxComp+i, 1);,
+                         MultiFab flxy(*flux[1], amrex::make_alias, fluxComp+i, 1);,
+                         MultiFab flxz(*flux[2], amrex::make_alias, fluxComp+i, 1););
+            std::array<MultiFab*,AMREX_SPACEDIM> fp{AMREX_D_DECL(&flxx,&flxy,&flxz)};
+            mlmg.getFluxes({fp});
+            for (int d = 0; d < BL_SPACEDIM; ++d) {
+                (*flux[d]).mult(b/(dt*navier_stokes->Geom().CellSize()[d]),fluxComp+i,1,0);
+            }
+        }
+
+        MultiFab::Copy(Ssync,Soln,0,sigma,1,0);
+
+        if (rho_flag == 2)
+        {
+            MultiFab& S_new = navier_stokes->get_new_data(State_Type);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+            for (MFIter Ssyncmfi(Ssync,true); Ssyncmfi.isValid(); ++Ssyncmfi)
+            {
+                Ssync[Ssyncmfi].mult(S_new[Ssyncmfi],Ssyncmfi.tilebox(),Density,sigma,1);
+            }
+        }
+    }
+
+    if (verbose)
+    {
+        const int IOProc   = ParallelDescriptor::IOProcessorNumber();
+        Real      run_time = ParallelDescriptor::second() - strt_time;
+
+        ParallelDescriptor::ReduceRealMax(run_time,IOProc);
+
+	amrex::Print() << "Diffusion::diffuse_Ssync(): lev: " << level
+		       << ", time: " << run_time << '\n';
+    }
+}
+
 void
 Diffusion::getTensorOp_doit (DivVis*                tensor_op,
                              Real                   a,
@@ -2232,6 +2899,18 @@ Diffusion::getBndryData (ViscBndry& bndry,
                          int        num_comp,
                          Real       time,
                          int        rho_flag)
+{
+    bndry.define(grids,dmap,num_comp,navier_stokes->Geom());
+
+    setBndryData(bndry,src_comp,num_comp,time,rho_flag);
+}
+
+void
+Diffusion::setBndryData (ViscBndry& bndry,
+                         int        src_comp,
+                         int        num_comp,
+                         Real       time,
+                         int        rho_flag)
 {
     BL_ASSERT(num_comp == 1);
     //
@@ -2243,15 +2922,16 @@ Diffusion::getBndryData (ViscBndry& bndry,
     const int     nGrow = 1;
     const BCRec&  bc    = navier_stokes->get_desc_lst()[State_Type].getBC(src_comp);
 
-    bndry.define(grids,dmap,num_comp,navier_stokes->Geom());
-
-    const MultiFab& rhotime = navier_stokes->get_rho(time);
-
     MultiFab S(grids, dmap, num_comp, nGrow);
 
     AmrLevel::FillPatch(*navier_stokes,S,nGrow,time,State_Type,src_comp,num_comp);
-
+    //
+    // The density is only known at the old, new and a few intermediate
+    // times, which is all rho_flag==2 needs; the other forms may also be
+    // filled at the stage times of diffuse_scalar_sts().
+    //
     if (rho_flag == 2) {
+        const MultiFab& rhotime = navier_stokes->get_rho(time);
         for (int n = 0; n < num_comp; ++n) {
 	    MultiFab::Divide(S,rhotime,0,n,1,nGrow);
 	}
@@ -2328,8 +3008,6 @@ Diffusion::FillBoundary (BndryRegister& bdry,
     //
     const int     nGrow = 1;
 
-    const MultiFab& rhotime = navier_stokes->get_rho(time);
-
     MultiFab S(navier_stokes->boxArray(),
                navier_stokes->DistributionMap(),
                num_comp,nGrow);
@@ -2337,6 +3015,7 @@ Diffusion::FillBoundary (BndryRegister& bdry,
     AmrLevel::FillPatch(*navier_stokes,S,nGrow,time,State_Type,state_ind,num_comp);
 
     if (rho_flag == 2) {
+        const MultiFab& rhotime = navier_stokes->get_rho(time);
         for (int n = 0; n < num_comp; ++n) {
 	    MultiFab::Divide(S,rhotime,0,n,1,nGrow);
 	}
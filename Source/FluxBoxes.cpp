@@ -3,7 +3,7 @@
 using namespace amrex;
 
 MultiFab**
-FluxBoxes::define (const AmrLevel* amr_level, int nvar, int nghost)
+FluxBoxes::define (const AmrLevel* amr_level, MemoryAccount& acc, int nvar, int nghost)
 {
     BL_ASSERT(data == 0);
     data = new MultiFab*[BL_SPACEDIM];
@@ -13,6 +13,10 @@ FluxBoxes::define (const AmrLevel* amr_level, int nvar, int nghost)
         const DistributionMapping& dm = amr_level->DistributionMap();
         data[dir] = new MultiFab(ba,dm,nvar,nghost);
     }
+    long nbytes = 0;
+    for (int dir = 0; dir < BL_SPACEDIM; dir++)
+        nbytes += MemoryAccount::bytes(*data[dir]);
+    tag = new MemoryAccount::Tag(acc, amr_level->Level(), MemoryAccount::Fluxes, nbytes);
     return data;
 }
 
@@ -26,5 +30,7 @@ FluxBoxes::clear ()
         }
         delete [] data;
         data = 0;
+        delete tag;
+        tag = 0;
     }
 }
@@ -1,14 +1,24 @@
-
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <streambuf>
+#include <list>
+#include <map>
+#include <mutex>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include <AMReX_REAL.H>
 #include <AMReX_Utility.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
 
 using namespace amrex;
 
@@ -22,71 +32,315 @@ using namespace amrex;
 
 extern "C" void FORT_GETPLANE(int* filename, int* len, Real* data, int* plane, int* ncomp, int* isswirltype);
 
-void
-FORT_GETPLANE (int* filename, int* len, Real* data, int* plane, int* ncomp, int* isswirltype)
+namespace
 {
-    static int         kmax;
-    static bool        first = true;
-    static Vector<long> offset;
-    std::string        flctfile;
-
-    for (int i = 0; i < *len; i++)
+    //
+    // Number of decoded planes kept per file and number of planes whose
+    // pages are requested ahead of the one last asked for.
+    //
+    int cache_planes = 16;
+    int read_ahead   = 2;
+    //
+    // An istream reading straight out of memory.
+    //
+    struct MemBuf
+        :
+        public std::streambuf
     {
-        char c = filename[i];
+        MemBuf (char* b, char* e) { setg(b, b, e); }
+    };
+    //
+    // A fluctuations file: the seekp() offsets from the HDR file, the DAT
+    // file mapped read-only, and an LRU cache of the planes decoded from it.
+    //
+    // The mapping is shared and read-only, so all ranks on a node share
+    // the one copy of the file in the page cache.  Reading ahead only asks
+    // the kernel for the pages of the next planes with madvise(); the
+    // planes are decoded, and errors reported, on the calling thread.
+    //
+    class FluctFile
+    {
+    public:
 
-        flctfile += c;
+        FluctFile (const std::string& name, int isswirltype);
+
+        ~FluctFile ();
+        //
+        // Copy the given plane of the given component into data.
+        //
+        void get (int plane, int comp, Real* data);
+
+    private:
+
+        typedef std::list<long>                                  LRU;
+        typedef std::pair<Vector<Real>, LRU::iterator>           Entry;
+
+        void decode (long rec, Vector<Real>& v) const;
+
+        void insert (long rec, Vector<Real>& v);
+
+        void willneed (long rec) const;
+
+        int                     kmax;
+        Vector<long>            offset;
+        Vector<long>            extent;
+
+        char*                   base;
+        size_t                  length;
+        std::string             dat;
+
+        std::map<long,Entry>    cache;
+        LRU                     lru;
+        std::mutex              mtx;
+    };
+
+    std::map<std::string,FluctFile*> files;
+
+    void
+    cleanup ()
+    {
+        for (std::map<std::string,FluctFile*>::iterator it = files.begin(); it != files.end(); ++it)
+            delete it->second;
+        files.clear();
     }
+}
+
+FluctFile::FluctFile (const std::string& flctfile, int isswirltype)
+    :
+    base(0),
+    length(0)
+{
+    //
+    // Read and save all the seekp() offsets in the inflow header file.
+    //
+    std::string hdr = flctfile; hdr += "/HDR";
+
+    std::ifstream ifs;
+
+    ifs.open(hdr.c_str(), std::ios::in);
 
-    if (first)
+    if (!ifs.good())
+        amrex::FileOpenFailed(hdr);
+
+    int  idummy;
+    Real rdummy;
+    //
+    // Hardwire loop max to 3 regardless of spacedim.
+    //
+    for (int i = 0; i < 3; i++)
+        ifs >> kmax;
+
+    ifs >> rdummy >> rdummy >> rdummy;
+    ifs >> idummy >> idummy >> idummy;
+
+    if (isswirltype)
     {
         //
-        // Read and save all the seekp() offsets in the inflow header file.
+        // Skip over fluct_times array.
         //
-        first = false;
+        for (int i = 0; i < kmax; i++)
+            ifs >> rdummy;
+    }
+
+    offset.resize(kmax * BL_SPACEDIM);
+
+    for (std::size_t i = 0; i < offset.size(); i++)
+        ifs >> offset[i];
+
+    dat = flctfile; dat += "/DAT";
+
+    const int fd = open(dat.c_str(), O_RDONLY);
+
+    if (fd < 0)
+        amrex::FileOpenFailed(dat);
+
+    struct stat sb;
+
+    if (fstat(fd, &sb) == 0 && sb.st_size > 0)
+    {
+        void* p = mmap(0, sb.st_size, PROT_READ, MAP_SHARED, fd, 0);
 
-        std::string hdr = flctfile; hdr += "/HDR";
+        if (p != MAP_FAILED)
+        {
+            base   = static_cast<char*>(p);
+            length = sb.st_size;
+        }
+    }
+
+    close(fd);
+
+    if (base == 0 && ParallelDescriptor::IOProcessor())
+        std::cout << "getplane(): mmap() of " << dat << " failed, reading with seekg()\n";
+    //
+    // A record runs up to the next offset in the file, or its end.
+    //
+    if (base != 0)
+    {
+        Vector<long> sorted(offset);
+        std::sort(sorted.begin(), sorted.end());
+
+        extent.resize(offset.size());
 
+        for (std::size_t i = 0; i < offset.size(); i++)
+        {
+            Vector<long>::const_iterator it = std::upper_bound(sorted.begin(), sorted.end(), offset[i]);
+            extent[i] = ((it == sorted.end()) ? long(length) : *it) - offset[i];
+        }
+    }
+}
+
+FluctFile::~FluctFile ()
+{
+    if (base != 0)
+        munmap(base, length);
+}
+
+void
+FluctFile::decode (long rec, Vector<Real>& v) const
+{
+    const long start = offset[rec];
+
+    FArrayBox fab;
+
+    if (base != 0)
+    {
+        if (start < 0 || static_cast<size_t>(start) >= length)
+            amrex::Abort("getplane(): offset past the end of " + dat);
+
+        MemBuf buf(base + start, base + length);
+        std::istream is(&buf);
+
+        fab.readFrom(is);
+    }
+    else
+    {
         std::ifstream ifs;
 
-        ifs.open(hdr.c_str(), std::ios::in);
+        ifs.open(dat.c_str(), std::ios::in);
 
         if (!ifs.good())
-            amrex::FileOpenFailed(hdr);
+            amrex::FileOpenFailed(dat);
+
+        ifs.seekg(start, std::ios::beg);
+
+        if (!ifs.good())
+            amrex::Abort("getplane(): seekg() failed");
+
+        fab.readFrom(ifs);
+    }
+
+    v.resize(fab.box().numPts());
+
+    memcpy(v.dataPtr(), fab.dataPtr(), fab.box().numPts()*sizeof(Real));
+}
+
+void
+FluctFile::insert (long rec, Vector<Real>& v)
+{
+    //
+    // Must be called with mtx held.
+    //
+    if (cache.count(rec)) return;
+
+    lru.push_front(rec);
+    cache[rec].first.swap(v);
+    cache[rec].second = lru.begin();
+
+    while (lru.size() > std::size_t(cache_planes))
+    {
+        cache.erase(lru.back());
+        lru.pop_back();
+    }
+}
 
-        int  idummy;
-        Real rdummy;
+void
+FluctFile::willneed (long rec) const
+{
+    const long start = offset[rec];
+
+    if (base == 0 || start < 0 || static_cast<size_t>(start) >= length || extent[rec] <= 0)
+        return;
+
+    const long page = sysconf(_SC_PAGESIZE);
+    const long lo   = (start / page) * page;
+    const long hi   = std::min(start + extent[rec], long(length));
+
+    madvise(base + lo, hi - lo, MADV_WILLNEED);
+}
+
+void
+FluctFile::get (int plane, int comp, Real* data)
+{
+    const long rec = plane + comp*kmax;
+
+    if (rec < 0 || std::size_t(rec) >= offset.size())
+        amrex::Abort("getplane(): plane out of range");
+
+    std::unique_lock<std::mutex> lock(mtx);
+
+    std::map<long,Entry>::iterator it = cache.find(rec);
+
+    if (it == cache.end())
+    {
         //
-        // Hardwire loop max to 3 regardless of spacedim.
+        // Decoded under the lock: FArrayBox::readFrom() is not safe to run
+        // from several threads at once.
         //
-        for (int i = 0; i < 3; i++)
-            ifs >> kmax;
+        Vector<Real> v;
+        decode(rec, v);
+        insert(rec, v);
+        it = cache.find(rec);
+    }
 
-        ifs >> rdummy >> rdummy >> rdummy;
-        ifs >> idummy >> idummy >> idummy;
+    lru.splice(lru.begin(), lru, it->second);
 
-        if (*isswirltype)
-        {
-            //
-            // Skip over fluct_times array.
-            //
-            for (int i = 0; i < kmax; i++)
-                ifs >> rdummy;
-        }
+    const Vector<Real>& v = it->second.first;
+
+    memcpy(data, v.dataPtr(), v.size()*sizeof(Real));
+    //
+    // Planes are read in order within a component; have the pages of the
+    // next ones read in while this one is used.
+    //
+    const long last = (comp + 1)*kmax;
+    for (long r = rec+1; r <= rec+read_ahead && r < last; r++)
+        if (!cache.count(r))
+            willneed(r);
+}
 
-        offset.resize(kmax * BL_SPACEDIM);
+void
+FORT_GETPLANE (int* filename, int* len, Real* data, int* plane, int* ncomp, int* isswirltype)
+{
+    std::string flctfile;
 
-        for (int i = 0; i < offset.size(); i++)
-            ifs >> offset[i];
+    for (int i = 0; i < *len; i++)
+    {
+        char c = filename[i];
+
+        flctfile += c;
     }
 
-    std::string dat = flctfile; dat += "/DAT";
+    FluctFile* ff;
 
-    std::ifstream ifs;
+#ifdef _OPENMP
+#pragma omp critical(getplane_files)
+#endif
+    {
+        if (files.empty())
+        {
+            ParmParse pp("inflow");
+            pp.query("cache_planes",cache_planes);
+            pp.query("read_ahead",read_ahead);
+            cache_planes = std::max(cache_planes, read_ahead+1);
+            amrex::ExecOnFinalize(cleanup);
+        }
 
-    ifs.open(dat.c_str(), std::ios::in);
+        std::map<std::string,FluctFile*>::iterator it = files.find(flctfile);
 
-    if (!ifs.good())
-        amrex::FileOpenFailed(dat);
+        if (it == files.end())
+            it = files.insert(std::make_pair(flctfile, new FluctFile(flctfile, *isswirltype))).first;
+
+        ff = it->second;
+    }
     //
     // There are BL_SPACEDIM * kmax planes of FABs.
     // The first component are in the first kmax planes,
@@ -94,16 +348,5 @@ FORT_GETPLANE (int* filename, int* len, Real* data, int* plane, int* ncomp, int*
     // Note also that both (*plane) and (*ncomp) start from
     // 1 not 0 since they're passed from Fortran.
     //
-    const long start = offset[((*plane) - 1) + (((*ncomp) - 1) * kmax)] ;
-
-    ifs.seekg(start, std::ios::beg);
-
-    if (!ifs.good())
-        amrex::Abort("getplane(): seekg() failed");
-
-    FArrayBox fab;
-
-    fab.readFrom(ifs);
-
-    memcpy(data, fab.dataPtr(), fab.box().numPts()*sizeof(Real));
+    ff->get((*plane) - 1, (*ncomp) - 1, data);
 }
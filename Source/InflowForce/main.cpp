@@ -13,6 +13,14 @@
 //
 // For a total of N lines.
 //
+// Every extended plane of every component is written as a one-component
+// FAB of the same size, so the offsets in HDR are known up front.  The
+// (component,time) records are then converted independently: they are
+// spread over the MPI ranks and, within a rank, over the OpenMP threads,
+// and each one reads only the component it needs from its input FAB and
+// writes straight to its place in DAT.  At any time a thread holds a
+// single component of a single plane.
+//
 
 #if BL_SPACEDIM != 3
 #error "This code only works for BL_SPACEDIM==3"
@@ -30,7 +38,9 @@
 #include <AMReX.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_Utility.H>
+#include <sstream>
 
 using namespace amrex;
 
@@ -67,31 +77,80 @@ usage ()
     exit(1);
 }
 
+//
+// Reads comp of the FAB in name; returns false, after saying why, if the
+// file is missing or does not hold a planar FAB with three components.
+// The records are read on every rank and thread, so errors are counted
+// by the caller instead of exiting.
+//
 static
-void
-GetFab (const std::string& name, FArrayBox& fab)
+bool
+GetFab (const std::string& name, FArrayBox& fab, int comp)
 {
     std::ifstream ifs(name.c_str(), std::ios::in);
 
-    if (verbose)
-        std::cout << "Attempting to read FAB from file: " << name << " ... " << std::flush;
-
-    fab.readFrom(ifs);
+    if (!ifs.good())
+    {
+        std::cout << "Cannot open FAB file: " << name << '\n';
+        return false;
+    }
 
     if (verbose)
-        std::cout << "done\n\n" << std::flush;
+        std::cout << "Reading component " << comp << " of FAB from file: " << name << '\n';
+    //
+    // Only read in the one component we need.
+    //
+    const int ncomp = fab.readFrom(ifs, comp);
 
     if (fab.box().length(2) != 1)
     {
-        std::cout << "Z dimension of FAB box is not one!\n";
-        usage();
+        std::cout << name << ": Z dimension of FAB box is not one!\n";
+        return false;
     }
 
-    if (fab.nComp() < 3)
+    if (ncomp < 3)
     {
-        std::cout << "FAB has fewer than three components!\n";
-        usage();
+        std::cout << name << ": FAB has fewer than three components!\n";
+        return false;
     }
+
+    return true;
+}
+
+//
+// Builds the extended, one-component record of comp for the given input.
+//
+static void Extend (FArrayBox& xfab, FArrayBox& vfab, const Box& dm);
+
+static
+bool
+MakeRecord (const std::string& name,
+            int                comp,
+            const Box&         domain,
+            std::string&       record)
+{
+    FArrayBox fab, xfab;
+
+    if (!GetFab(name, fab, comp))
+        return false;
+
+    const int len = (comp == 2) ? 1 : domain.length(comp);
+
+    if (fab.box().length(comp) != len)
+    {
+        std::cout << name << ": FAB does not have correct length in dim = " << comp << "!\n";
+        return false;
+    }
+
+    Extend(xfab, fab, domain);
+
+    std::ostringstream os;
+
+    xfab.writeOn(os,0,1);
+
+    record = os.str();
+
+    return true;
 }
 
 static
@@ -241,88 +300,135 @@ main (int   argc,
     }
     std::cout << '\n';
 
-    if (!amrex::UtilCreateDirectory(ofile, 0755))
-        amrex::CreateDirectoryFailed(ofile);
+    std::vector<Line> lines(LL.begin(), LL.end());
 
-    std::string Hdr = ofile; Hdr += "/HDR";
-    std::string Dat = ofile; Dat += "/DAT";
+    const bool ioproc = ParallelDescriptor::IOProcessor();
 
-    std::ofstream ohdr, odat;
+    if (ioproc)
+        if (!amrex::UtilCreateDirectory(ofile, 0755))
+            amrex::CreateDirectoryFailed(ofile);
 
-    ohdr.open(Hdr.c_str(), std::ios::out|std::ios::trunc);
-    if (!ohdr.good())
-        amrex::FileOpenFailed(Hdr);
-
-    odat.open(Dat.c_str(), std::ios::out|std::ios::trunc);
-    if (!odat.good())
-        amrex::FileOpenFailed(Dat);
+    std::string Hdr = ofile; Hdr += "/HDR";
+    std::string Dat = ofile; Dat += "/DAT";
     //
     // Gotta open a FAB to get initial NX and NY.
+    // Its record also gives the size of every record in DAT.
     //
-    FArrayBox fab, xfab;
+    FArrayBox fab;
+
+    if (!GetFab(lines[0].m_name, fab, 0))
+        amrex::Abort("turbMerge: cannot read the first FAB");
 
-    GetFab(LL.front().m_name, fab);
-    
     const int NX = fab.box().length(0);
     const int NY = fab.box().length(1);
-    const int NZ = LL.size();
+    const int NZ = lines.size();
 
     const Box domain(IntVect(0,0,0), IntVect(NX-1,NY-1,0));
 
     const Real DX[BL_SPACEDIM] = {probsize[0]/NX, probsize[1]/NY, 1};
 
-    ohdr << NX + 3 << ' '
-         << NY + 3 << ' '
-         << NZ     << '\n';
+    std::string record;
 
-    ohdr << probsize[0] + 2*DX[0] << ' '
-         << probsize[1] + 2*DX[1] << ' '
-         << probsize[2]           << '\n';
+    if (!MakeRecord(lines[0].m_name, 0, domain, record))
+        amrex::Abort("turbMerge: cannot build the first record");
 
-    ohdr << 1 << ' ' << 1 << ' ' << 1 << '\n';
+    const std::size_t recsize = record.size();
 
-    for (std::list<Line>::const_iterator it = LL.begin(); it != LL.end(); ++it)
+    if (ioproc)
     {
-        ohdr << it->m_time << '\n';
+        std::ofstream ohdr, odat;
+
+        ohdr.open(Hdr.c_str(), std::ios::out|std::ios::trunc);
+        if (!ohdr.good())
+            amrex::FileOpenFailed(Hdr);
+
+        odat.open(Dat.c_str(), std::ios::out|std::ios::trunc);
+        if (!odat.good())
+            amrex::FileOpenFailed(Dat);
+
+        ohdr << NX + 3 << ' '
+             << NY + 3 << ' '
+             << NZ     << '\n';
+
+        ohdr << probsize[0] + 2*DX[0] << ' '
+             << probsize[1] + 2*DX[1] << ' '
+             << probsize[2]           << '\n';
+
+        ohdr << 1 << ' ' << 1 << ' ' << 1 << '\n';
+
+        for (int t = 0; t < NZ; t++)
+        {
+            ohdr << lines[t].m_time << '\n';
+        }
+        //
+        // The FABs are stored one slab at a time.
+        //
+        // All X's, then all the Y,s, then all the Z's.
+        //
+        for (long r = 0; r < BL_SPACEDIM*NZ; r++)
+        {
+            ohdr << r*recsize << '\n';
+        }
     }
+
+    ParallelDescriptor::Barrier();
     //
-    // Write out the FABS one slab at a time.
-    //
-    // All X's, then all the Y,s, then all the Z's.
+    // Record r holds component r/NZ of time r%NZ.
     //
-    for (int i = 0; i < BL_SPACEDIM; i++)
-    {
-        int len;
+    const int nrec   = BL_SPACEDIM*NZ;
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int myproc = ParallelDescriptor::MyProc();
 
-        switch(i)
+    int nbad = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:nbad)
+#endif
+    {
+        std::fstream odat(Dat.c_str(), std::ios::in|std::ios::out|std::ios::binary);
+        if (!odat.good())
         {
-        case 0: len = NX; break;
-        case 1: len = NY; break;
-        case 2: len = 1;  break;
-        default:
-            amrex::Abort("turbMerge: how did this happen?");
+            std::cout << "Cannot open " << Dat << " for writing!\n";
+            nbad++;
         }
 
-        for (std::list<Line>::const_iterator it = LL.begin(); it != LL.end(); ++it)
+        std::string rec;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+        for (int r = myproc; r < nrec; r += nprocs)
         {
-            GetFab(it->m_name, fab);
+            const int comp = r / NZ;
+            const int t    = r % NZ;
 
-            if (fab.box().length(i) != len)
+            if (!MakeRecord(lines[t].m_name, comp, domain, rec))
             {
-                std::cout << "FAB does not have correct length in dim = " << i << "!\n";
-                usage();
+                nbad++;
+                continue;
             }
 
-            Extend(xfab, fab, domain);
+            if (rec.size() != recsize)
+            {
+                std::cout << lines[t].m_name << ": record size differs from that of "
+                          << lines[0].m_name << "!\n";
+                nbad++;
+                continue;
+            }
 
-            ohdr << odat.tellp() << '\n';
-            //
-            // Write the extended FAB to the data file.
-            //
-            xfab.writeOn(odat,i,1);
+            odat.seekp(long(r)*recsize, std::ios::beg);
+            odat.write(rec.data(), recsize);
         }
+
+        if (!odat.good())
+            nbad++;
     }
 
+    ParallelDescriptor::ReduceIntSum(nbad);
+
+    if (nbad > 0)
+        amrex::Abort("turbMerge: bad input FABs or failed writing DAT");
+
     amrex::Finalize();
 
     return 0;
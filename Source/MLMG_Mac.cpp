@@ -4,6 +4,7 @@
 #include <AMReX_ParmParse.H>
 
 #include <MacOpMacDrivers.H>
+#include <SolverStats.H>
 
 #include <IAMR_MLMG_F.H>
 
@@ -114,6 +115,8 @@ void mlmg_mac_level_solve (Amr* parent, const MultiFab* cphi, const BCRec& phys_
  
         initialized = true;
     }
+
+    const Real strt_time = ParallelDescriptor::second();
     
     const Geometry& geom = parent->Geom(level);
     const BoxArray& ba = Rhs.boxArray();
@@ -159,9 +162,14 @@ void mlmg_mac_level_solve (Amr* parent, const MultiFab* cphi, const BCRec& phys_
 
     const Real* dxinv = geom.InvCellSize();
     compute_mac_rhs(Rhs, u_mac, area, volume, dxinv);
+
+    const Real solve_time = ParallelDescriptor::second();
         
     mlmg.solve({mac_phi}, {&Rhs}, mac_tol, mac_abs_tol);
 
+    SolverStats::add("mac", level, mlmg, solve_time - strt_time,
+                     ParallelDescriptor::second() - solve_time);
+
     auto& fluxes = bcoefs;
     mlmg.getFluxes({amrex::GetArrOfPtrs(fluxes)});
     for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
@@ -188,6 +196,8 @@ void mlmg_mac_sync_solve (Amr* parent, const BCRec& phys_bc,
         initialized = true;
     }
 
+    const Real strt_time = ParallelDescriptor::second();
+
     const Geometry& geom = parent->Geom(level);
     const BoxArray& ba = Rhs.boxArray();
     const DistributionMapping& dm = Rhs.DistributionMap();
@@ -233,6 +243,12 @@ void mlmg_mac_sync_solve (Amr* parent, const BCRec& phys_bc,
     Rhs.negate();
 
     mlmg.setFinalFillBC(true);
+
+    const Real solve_time = ParallelDescriptor::second();
+
     mlmg.solve({mac_phi}, {&Rhs}, mac_tol, mac_abs_tol);
+
+    SolverStats::add("mac_sync", level, mlmg, solve_time - strt_time,
+                     ParallelDescriptor::second() - solve_time);
 }
 
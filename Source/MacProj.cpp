@@ -404,6 +404,8 @@ MacProj::mac_project (int             level,
     //
     const Real rhs_scale = 2.0/dt;
     MultiFab Rhs(grids,dmap,1,0);
+    MemoryAccount::Tag work_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(Rhs));
 
     Rhs.copy(divu);
 
@@ -414,6 +416,10 @@ MacProj::mac_project (int             level,
 	    MultiFab::Copy(area_tmp[i], area_level[i], 0, 0, 1, 1);
 	}
         scaleArea(level,area_tmp,anel_coeff[level]);
+        long nbytes = MemoryAccount::bytes(Rhs);
+        for (int i = 0; i < BL_SPACEDIM; ++i)
+            nbytes += MemoryAccount::bytes(area_tmp[i]);
+        work_tag.grow(nbytes);
     } 
 
     const MultiFab* area = (anel_coeff[level] != 0) ? area_tmp : area_level;
@@ -540,6 +546,8 @@ MacProj::mac_sync_solve (int       level,
     // value of zero (including crse cells under fine grids).
     //
     MultiFab Rhs(grids,dmap,1,0);
+    MemoryAccount::Tag work_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(Rhs));
     Rhs.setVal(0.0);
     //
     // Reflux subtracts values at hi edge of coarse cell and
@@ -666,6 +674,10 @@ MacProj::mac_sync_solve (int       level,
 	    MultiFab::Copy(area_tmp[i], area_level[i], 0, 0, 1, 1);
 	}
         scaleArea(level,area_tmp,anel_coeff[level]);
+        long nbytes = MemoryAccount::bytes(Rhs);
+        for (int i = 0; i < BL_SPACEDIM; ++i)
+            nbytes += MemoryAccount::bytes(area_tmp[i]);
+        work_tag.grow(nbytes);
     } 
 
     const MultiFab* area = (anel_coeff[level] != 0) ? area_tmp : area_level;
@@ -746,6 +758,8 @@ MacProj::mac_sync_solve (int       level,
     // value of zero (including crse cells under fine grids).
     //
     MultiFab Rhs(grids,dmap,1,0);
+    MemoryAccount::Tag work_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(Rhs));
     Rhs.setVal(0.0);
     //
     // Reflux subtracts values at hi edge of coarse cell and
@@ -882,6 +896,10 @@ MacProj::mac_sync_solve (int       level,
 	    MultiFab::Copy(area_tmp[i], area_level[i], 0, 0, 1, 1);
 	}
         scaleArea(level,area_tmp,anel_coeff[level]);
+        long nbytes = MemoryAccount::bytes(Rhs);
+        for (int i = 0; i < BL_SPACEDIM; ++i)
+            nbytes += MemoryAccount::bytes(area_tmp[i]);
+        work_tag.grow(nbytes);
     } 
 
     const MultiFab* area = (anel_coeff[level] != 0) ? area_tmp : area_level;
@@ -995,15 +1013,25 @@ MacProj::mac_sync_compute (int                   level,
     //
     MultiFab fluxes[BL_SPACEDIM];
     MultiFab mac_fluxes[BL_SPACEDIM];
+    long nflux = 0;
     for (int i = 0; i < BL_SPACEDIM; i++) {
       const BoxArray& ba = LevelData[level]->getEdgeBoxArray(i);
       fluxes[i].define(ba, dmap, NUM_STATE, 0);
       mac_fluxes[i].define(ba, dmap, 1, 0);
+      nflux += MemoryAccount::bytes(fluxes[i]) + MemoryAccount::bytes(mac_fluxes[i]);
     }
+    MemoryAccount::Tag flux_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::Fluxes, nflux);
         
     FillPatchIterator S_fpi(ns_level,vel_visc_terms,Godunov::hypgrow(),
                                  prev_time,State_Type,0,NUM_STATE);
     MultiFab& Smf = S_fpi.get_mf();
+
+    MemoryAccount::Tag work_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::SolverWork,
+                                MemoryAccount::bytes(vel_visc_terms) + MemoryAccount::bytes(scal_visc_terms) +
+                                MemoryAccount::bytes(Gp) + MemoryAccount::bytes(*divu_fp) +
+                                MemoryAccount::bytes(Smf));
 #ifdef _OPENMP
 #pragma omp parallel 
 #endif
@@ -1019,6 +1047,7 @@ MacProj::mac_sync_compute (int                   level,
         FArrayBox& S    = Smf[Smfi];
         FArrayBox& divu = (*divu_fp)[Smfi];
         const Box bx = Smfi.tilebox();
+        const Real strt_time = ParallelDescriptor::second();
         //
         // Step 1: compute ucorr = grad(phi)/rhonph
         //
@@ -1136,6 +1165,7 @@ MacProj::mac_sync_compute (int                   level,
         //
         // Multiply the sync term by dt -- now done in the calling routine.
         //
+        ns_level.addWork(Smfi, ParallelDescriptor::second() - strt_time);
       }
     } //end OMP parallel region
     if (level > 0 && update_fluxreg){
@@ -1185,10 +1215,14 @@ MacProj::mac_sync_compute (int                    level,
 
     Godunov godunov(512);
     MultiFab fluxes[BL_SPACEDIM];
+    long nflux = 0;
     for (int i = 0; i < BL_SPACEDIM; i++) {
       const BoxArray& ba = LevelData[level]->getEdgeBoxArray(i);
       fluxes[i].define(ba, dmap, 1, 0);
+      nflux += MemoryAccount::bytes(fluxes[i]);
     }
+    MemoryAccount::Tag flux_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::Fluxes, nflux);
 
     //
     // Compute the mac sync correction.
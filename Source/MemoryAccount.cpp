@@ -0,0 +1,224 @@
+
+#include <iomanip>
+#include <ostream>
+#include <algorithm>
+
+#include <sys/resource.h>
+
+#include <AMReX_FabSet.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <MemoryAccount.H>
+
+using namespace amrex;
+
+namespace
+{
+    const char* cat_names[MemoryAccount::NumCategories] =
+    {
+        "state", "geometry", "u_mac", "aofs", "density", "sync", "transport", "registers",
+        "fluxes", "solver", "godunov"
+    };
+
+    void
+    printBytes (std::ostream& os, long b)
+    {
+        os << std::setw(10) << std::fixed << std::setprecision(1) << b/(1024.0*1024.0);
+    }
+}
+
+const char*
+MemoryAccount::name (int cat)
+{
+    return cat_names[cat];
+}
+
+long
+MemoryAccount::bytes (const MultiFab& mf)
+{
+    if (!mf.ok())
+        return 0;
+
+    long n = 0;
+
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+        n += mf[mfi].nBytes();
+
+    return n;
+}
+
+long
+MemoryAccount::bytes (const BndryRegister& reg)
+{
+    long n = 0;
+
+    for (OrientationIter fi; fi; ++fi)
+    {
+        const FabSet& fs = reg[fi()];
+
+        for (FabSetIter fsi(fs); fsi.isValid(); ++fsi)
+            n += fs[fsi].nBytes();
+    }
+
+    return n;
+}
+
+void
+MemoryAccount::set (int  lev,
+                    int  cat,
+                    long nbytes)
+{
+    if (cur.size() <= lev)
+    {
+        cur.resize(lev+1, Vector<long>(NumCategories,0));
+        high.resize(lev+1, Vector<long>(NumCategories,0));
+    }
+
+    cur[lev][cat]  = nbytes;
+    high[lev][cat] = std::max(high[lev][cat], nbytes);
+}
+
+void
+MemoryAccount::add (int  lev,
+                    int  cat,
+                    long nbytes)
+{
+#ifdef _OPENMP
+#pragma omp critical (memory_account)
+#endif
+    {
+        if (cur.size() <= lev)
+        {
+            cur.resize(lev+1, Vector<long>(NumCategories,0));
+            high.resize(lev+1, Vector<long>(NumCategories,0));
+        }
+
+        cur[lev][cat] += nbytes;
+        high[lev][cat] = std::max(high[lev][cat], cur[lev][cat]);
+    }
+}
+
+MemoryAccount::Tag::Tag (MemoryAccount& acc_,
+                         int            lev_,
+                         int            cat_,
+                         long           nbytes)
+    :
+    acc(acc_),
+    lev(lev_),
+    cat(cat_),
+    held(0)
+{
+    grow(nbytes);
+}
+
+MemoryAccount::Tag::~Tag ()
+{
+    if (held > 0)
+        acc.add(lev, cat, -held);
+}
+
+void
+MemoryAccount::Tag::grow (long nbytes)
+{
+    if (nbytes > held)
+    {
+        acc.add(lev, cat, nbytes-held);
+        held = nbytes;
+    }
+}
+
+void
+MemoryAccount::truncate (int finest)
+{
+    for (int lev = finest+1; lev < cur.size(); lev++)
+        std::fill(cur[lev].begin(), cur[lev].end(), 0);
+}
+
+void
+MemoryAccount::reduce ()
+{
+    const int nlev = cur.size();
+    const int N    = nlev*NumCategories;
+    //
+    // Current and high-water bytes of every level and category, and last
+    // the peak resident size of the process.
+    //
+    Vector<long> vmax(2*N+1), vsum(N);
+
+    for (int lev = 0; lev < nlev; lev++)
+    {
+        for (int c = 0; c < NumCategories; c++)
+        {
+            vmax[lev*NumCategories+c]   = cur[lev][c];
+            vmax[N+lev*NumCategories+c] = high[lev][c];
+            vsum[lev*NumCategories+c]   = cur[lev][c];
+        }
+    }
+
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    vmax[2*N] = long(ru.ru_maxrss) * 1024;   // kilobytes on Linux
+
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+
+    ParallelDescriptor::ReduceLongMax(vmax.dataPtr(), 2*N+1, IOProc);
+    if (N > 0)
+        ParallelDescriptor::ReduceLongSum(vsum.dataPtr(), N, IOProc);
+
+    max_cur.assign(nlev, Vector<long>(NumCategories));
+    max_high.assign(nlev, Vector<long>(NumCategories));
+    sum_cur.assign(nlev, Vector<long>(NumCategories));
+
+    for (int lev = 0; lev < nlev; lev++)
+    {
+        for (int c = 0; c < NumCategories; c++)
+        {
+            max_cur[lev][c]  = vmax[lev*NumCategories+c];
+            max_high[lev][c] = vmax[N+lev*NumCategories+c];
+            sum_cur[lev][c]  = vsum[lev*NumCategories+c];
+        }
+    }
+
+    max_rss = vmax[2*N];
+}
+
+void
+MemoryAccount::print (std::ostream& os) const
+{
+    const std::ios_base::fmtflags oflags = os.flags();
+    const std::streamsize         oprec  = os.precision();
+
+    os << "MB per level and category: current maximum over the ranks, high-water\n"
+       << "maximum over the ranks, current total\n";
+
+    for (int lev = 0; lev < max_cur.size(); lev++)
+    {
+        long tcur = 0, thigh = 0, tsum = 0;
+
+        for (int c = 0; c < NumCategories; c++)
+        {
+            os << "  level " << lev << ' ' << std::setw(10) << std::left << name(c) << std::right;
+            printBytes(os, max_cur[lev][c]);
+            printBytes(os, max_high[lev][c]);
+            printBytes(os, sum_cur[lev][c]);
+            os << '\n';
+
+            tcur  += max_cur[lev][c];
+            thigh += max_high[lev][c];
+            tsum  += sum_cur[lev][c];
+        }
+
+        os << "  level " << lev << ' ' << std::setw(10) << std::left << "all" << std::right;
+        printBytes(os, tcur);
+        printBytes(os, thigh);
+        printBytes(os, tsum);
+        os << '\n';
+    }
+
+    os << "peak resident size of the largest rank (MB): ";
+    printBytes(os, max_rss);
+    os << '\n';
+
+    os.flags(oflags);
+    os.precision(oprec);
+}
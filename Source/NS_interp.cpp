@@ -0,0 +1,283 @@
+
+#include <algorithm>
+
+#include <NS_interp.H>
+#include <NAVIERSTOKES_F.H>
+
+using namespace amrex;
+
+namespace
+{
+    //
+    // Index arithmetic of a FAB, with the dimensions beyond BL_SPACEDIM
+    // collapsed to the single index 0.
+    //
+    struct Layout
+    {
+        int  lo[3];
+        long js, ks;
+
+        explicit Layout (const Box& b)
+        {
+            lo[0] = lo[1] = lo[2] = 0;
+            for (int d = 0; d < BL_SPACEDIM; d++)
+                lo[d] = b.smallEnd(d);
+            js = b.length(0);
+            ks = (BL_SPACEDIM > 2) ? js*b.length(1) : 0;
+        }
+
+        long operator() (int i, int j, int k) const
+        {
+            return (i-lo[0]) + (j-lo[1])*js + (k-lo[2])*ks;
+        }
+    };
+    //
+    // The bounds of bx and the ratio R in three dimensions.
+    //
+    template <int R>
+    void
+    bounds (const Box& bx, int* lo, int* hi, int* r)
+    {
+        for (int d = 0; d < 3; d++)
+        {
+            lo[d] = hi[d] = 0;
+            r[d]  = 1;
+        }
+        for (int d = 0; d < BL_SPACEDIM; d++)
+        {
+            lo[d] = bx.smallEnd(d);
+            hi[d] = bx.bigEnd(d);
+            r[d]  = R;
+        }
+    }
+
+    template <int R>
+    void
+    edge_interp_r (const Box& fbox,
+                   int        nc,
+                   int        dir,
+                   FArrayBox& fine)
+    {
+        const Layout f(fine.box());
+
+        int lo[3], hi[3], r[3];
+        bounds<R>(fbox,lo,hi,r);
+
+        const int nx = hi[0] - lo[0] + 1;
+
+        for (int n = 0; n < nc; n++)
+        {
+            Real* fp = fine.dataPtr(n);
+
+            if (dir == 0)
+            {
+                for (int k = lo[2]; k <= hi[2]; k += r[2])
+                for (int j = lo[1]; j <= hi[1]; j += r[1])
+                {
+                    const Real* src = fp + f(lo[0],j,k);
+
+                    for (int L = k; L <= std::min(k+r[2]-1,hi[2]); L++)
+                    for (int P = j; P <= std::min(j+r[1]-1,hi[1]); P++)
+                    {
+                        Real* dst = fp + f(lo[0],P,L);
+
+                        for (int i = 0; i < nx-R; i += R)
+                        {
+                            const Real df = src[i+R] - src[i];
+                            for (int M = 1; M < R; M++)
+                                dst[i+M] = src[i] + df*Real(M)/Real(R);
+                        }
+                    }
+                }
+            }
+            else if (dir == 1)
+            {
+                for (int k = lo[2]; k <= hi[2];   k += r[2])
+                for (int j = lo[1]; j <= hi[1]-R; j += R)
+                {
+                    const Real* s0 = fp + f(lo[0],j,  k);
+                    const Real* s1 = fp + f(lo[0],j+R,k);
+
+                    for (int M = 1; M < R; M++)
+                    for (int L = k; L <= std::min(k+r[2]-1,hi[2]); L++)
+                    {
+                        Real* dst = fp + f(lo[0],j+M,L);
+
+                        for (int i = 0; i < nx; i++)
+                            dst[i] = s0[i] + (s1[i]-s0[i])*Real(M)/Real(R);
+                    }
+                }
+            }
+            else
+            {
+                for (int k = lo[2]; k <= hi[2]-R; k += R)
+                for (int j = lo[1]; j <= hi[1];   j += r[1])
+                {
+                    const Real* s0 = fp + f(lo[0],j,k);
+                    const Real* s1 = fp + f(lo[0],j,k+R);
+
+                    for (int M = 1; M < R; M++)
+                    for (int L = j; L <= std::min(j+r[1]-1,hi[1]); L++)
+                    {
+                        Real* dst = fp + f(lo[0],L,k+M);
+
+                        for (int i = 0; i < nx; i += R)
+                        {
+                            const Real val = s0[i] + (s1[i]-s0[i])*Real(M)/Real(R);
+                            const int  np  = std::min(R,nx-i);
+                            for (int p = 0; p < np; p++)
+                                dst[i+p] = val;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    template <int R>
+    void
+    pc_edge_interp_r (const Box&       cbox,
+                      int              nc,
+                      int              dir,
+                      const FArrayBox& crse,
+                      FArrayBox&       fine)
+    {
+        const Layout c(crse.box());
+        const Layout f(fine.box());
+
+        int lo[3], hi[3], r[3];
+        bounds<R>(cbox,lo,hi,r);
+
+        const int nx = hi[0] - lo[0] + 1;
+
+        for (int n = 0; n < nc; n++)
+        {
+            const Real* cp = crse.dataPtr(n);
+            Real*       fp = fine.dataPtr(n);
+
+            for (int k = lo[2]; k <= hi[2]; k++)
+            for (int j = lo[1]; j <= hi[1]; j++)
+            {
+                const Real* src = cp + c(lo[0],j,k);
+
+                if (dir == 0)
+                {
+                    for (int P = 0; P < r[2]; P++)
+                    for (int L = 0; L < r[1]; L++)
+                    {
+                        Real* dst = fp + f(R*lo[0],r[1]*j+L,r[2]*k+P);
+
+                        for (int i = 0; i < nx; i++)
+                            dst[R*i] = src[i];
+                    }
+                }
+                else
+                {
+                    //
+                    // The fine faces making up a coarse face of direction
+                    // 1 or 2 are contiguous in the first direction.
+                    //
+                    for (int P = 0; P < ((dir == 1) ? r[2] : r[1]); P++)
+                    {
+                        Real* dst = (dir == 1) ? fp + f(R*lo[0],R*j,r[2]*k+P)
+                                               : fp + f(R*lo[0],R*j+P,R*k);
+
+                        for (int i = 0; i < nx; i++)
+                            for (int L = 0; L < R; L++)
+                                dst[R*i+L] = src[i];
+                    }
+                }
+            }
+        }
+    }
+
+    template <int R>
+    void
+    putdown_r (const Box&       ovlp,
+               const FArrayBox& fine,
+               FArrayBox&       crse)
+    {
+        const Layout c(crse.box());
+        const Layout f(fine.box());
+
+        int lo[3], hi[3], r[3];
+        bounds<R>(ovlp,lo,hi,r);
+
+        const int nx = hi[0] - lo[0] + 1;
+
+        const Real* fp = fine.dataPtr();
+        Real*       cp = crse.dataPtr();
+
+        for (int k = lo[2]; k <= hi[2]; k++)
+        for (int j = lo[1]; j <= hi[1]; j++)
+        {
+            const Real* src = fp + f(R*lo[0],R*j,r[2]*k);
+            Real*       dst = cp + c(lo[0],j,k);
+
+            for (int i = 0; i < nx; i++)
+                dst[i] = src[R*i];
+        }
+    }
+
+    int
+    uniformRatio (const IntVect& ratio)
+    {
+        for (int d = 1; d < BL_SPACEDIM; d++)
+            if (ratio[d] != ratio[0])
+                return 0;
+        return ratio[0];
+    }
+}
+
+void
+NSInterp::edge_interp (const Box&     fbox,
+                       int            nc,
+                       const IntVect& ratio,
+                       int            dir,
+                       FArrayBox&     fine)
+{
+    switch (uniformRatio(ratio))
+    {
+    case 2: edge_interp_r<2>(fbox,nc,dir,fine); break;
+    case 4: edge_interp_r<4>(fbox,nc,dir,fine); break;
+    default:
+        ::edge_interp(fbox.loVect(), fbox.hiVect(), &nc, ratio.getVect(), &dir,
+                      fine.dataPtr(), ARLIM(fine.loVect()), ARLIM(fine.hiVect()));
+    }
+}
+
+void
+NSInterp::pc_edge_interp (const Box&       cbox,
+                          int              nc,
+                          const IntVect&   ratio,
+                          int              dir,
+                          const FArrayBox& crse,
+                          FArrayBox&       fine)
+{
+    switch (uniformRatio(ratio))
+    {
+    case 2: pc_edge_interp_r<2>(cbox,nc,dir,crse,fine); break;
+    case 4: pc_edge_interp_r<4>(cbox,nc,dir,crse,fine); break;
+    default:
+        ::pc_edge_interp(cbox.loVect(), cbox.hiVect(), &nc, ratio.getVect(), &dir,
+                         crse.dataPtr(), ARLIM(crse.loVect()), ARLIM(crse.hiVect()),
+                         fine.dataPtr(), ARLIM(fine.loVect()), ARLIM(fine.hiVect()));
+    }
+}
+
+void
+NSInterp::putdown (const Box&       ovlp,
+                   const FArrayBox& fine,
+                   FArrayBox&       crse,
+                   const IntVect&   ratio)
+{
+    switch (uniformRatio(ratio))
+    {
+    case 2: putdown_r<2>(ovlp,fine,crse); break;
+    case 4: putdown_r<4>(ovlp,fine,crse); break;
+    default:
+        fort_putdown(crse.dataPtr(), ARLIM(crse.loVect()), ARLIM(crse.hiVect()),
+                     fine.dataPtr(), ARLIM(fine.loVect()), ARLIM(fine.hiVect()),
+                     ovlp.loVect(), ovlp.hiVect(), ratio.getVect());
+    }
+}
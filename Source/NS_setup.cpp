@@ -138,6 +138,56 @@ set_dsdt_bc(BCRec& bc, const BCRec& phys_bc)
 
 typedef StateDescriptor::BndryFunc BndryFunc;
 
+//
+// Names of the components of the running statistics, in the order the
+// ns_basicstats kernels accumulate them, followed by the accumulated time.
+//
+static
+Vector<std::string>
+running_stats_names ()
+{
+    const char* vel[] = { "u", "v", "w" };
+
+    Vector<std::string> names;
+
+    for (int n = 1; n <= 2; n++)
+    {
+        const std::string pw = (n == 1) ? "" : "2";
+
+        names.push_back("stat_rho" + pw);
+        for (int d = 0; d < BL_SPACEDIM; d++)
+        {
+            names.push_back(std::string("stat_") + vel[d] + pw);
+            names.push_back(std::string("stat_rho_") + vel[d] + pw);
+        }
+        names.push_back("stat_tr" + pw);
+        names.push_back("stat_rho_tr" + pw);
+        names.push_back("stat_p" + pw);
+    }
+
+    for (int rho = 0; rho <= 1; rho++)
+    {
+        const std::string pre = rho ? "stat_rho_" : "stat_";
+        for (int d1 = 0; d1 < BL_SPACEDIM; d1++)
+            for (int d2 = d1+1; d2 < BL_SPACEDIM; d2++)
+                names.push_back(pre + vel[d1] + vel[d2]);
+    }
+
+    for (int rho = 0; rho <= 1; rho++)
+    {
+        const std::string pre = rho ? "stat_rho_" : "stat_";
+        for (int d = 0; d < BL_SPACEDIM; d++)
+            names.push_back(pre + vel[d] + "_tr");
+    }
+
+    for (int d = 0; d < BL_SPACEDIM; d++)
+        names.push_back(std::string("stat_") + vel[d] + "_p");
+
+    names.push_back("stat_time");
+
+    return names;
+}
+
 void
 NavierStokes::variableSetUp ()
 {
@@ -304,6 +354,36 @@ NavierStokes::variableSetUp ()
 	desc_lst.setComponent(Dsdt_Type,Dsdt,"dsdt",bc,BndryFunc(FORT_DSDTFILL));
     }
     //
+    // **************  DEFINE RUNNING STATISTICS  ********************
+    //
+    if (do_running_statistics)
+    {
+	// stick Stats_Type on the end of the descriptor list
+	const Vector<std::string> names = running_stats_names();
+	Stats_Type = desc_lst.size();
+	desc_lst.addDescriptor(Stats_Type,IndexType::TheCellType(),
+                               StateDescriptor::Point,0,names.size(),
+			       &cell_cons_interp);
+	for (int n = 0; n < names.size(); n++)
+	{
+	    set_divu_bc(bc,phys_bc);
+	    desc_lst.setComponent(Stats_Type,n,names[n],bc,BndryFunc(FORT_DIVUFILL));
+	}
+    }
+    //
+    // **************  DEFINE WORK ESTIMATES  ********************
+    //
+    if (do_work_estimates)
+    {
+	// stick Work_Type on the end of the descriptor list
+	Work_Type = desc_lst.size();
+	desc_lst.addDescriptor(Work_Type,IndexType::TheCellType(),
+                               StateDescriptor::Point,0,1,
+			       &pc_interp);
+	set_divu_bc(bc,phys_bc);
+	desc_lst.setComponent(Work_Type,0,"work_est",bc,BndryFunc(FORT_DIVUFILL));
+    }
+    //
     // **************  DEFINE DERIVED QUANTITIES ********************
     //
     // mod grad rho
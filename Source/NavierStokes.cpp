@@ -12,6 +12,7 @@
 #include <AMReX_Extrapolater.H>
 #include <AMReX_ParmParse.H>
 #include <NavierStokes.H>
+#include <SolverStats.H>
 #include <AMReX_MultiGrid.H>
 #include <NAVIERSTOKES_F.H>
 #include <AMReX_BLProfiler.H>
@@ -217,6 +218,12 @@ NavierStokes::initData ()
         get_new_data(Dpdt_Type).setVal(0);
     }
 
+    if (do_running_statistics)
+        get_new_data(Stats_Type).setVal(0);
+
+    if (do_work_estimates)
+        get_new_data(Work_Type).setVal(0);
+
     is_first_step_after_regrid = false;
     old_intersect_new          = grids;
 
@@ -291,6 +298,8 @@ NavierStokes::advance (Real time,
     if (do_mac_proj) 
     {
         MultiFab mac_rhs(grids,dmap,1,0);
+        MemoryAccount::Tag rhs_tag(theMemoryAccount(), level, MemoryAccount::SolverWork,
+                                   MemoryAccount::bytes(mac_rhs));
         create_mac_rhs(mac_rhs,0,time,dt);
         MultiFab& S_old = get_old_data(State_Type);
         mac_project(time,dt,S_old,&mac_rhs,umac_n_grow,true);
@@ -372,7 +381,12 @@ NavierStokes::advance (Real time,
 #ifdef AMREX_PARTICLES
     if (theNSPC() != 0 and NavierStokes::initial_iter != true)
     {
+        const Real strt_time = ParallelDescriptor::second();
+
         theNSPC()->AdvectWithUmac(u_mac, level, dt);
+        theParticleSorter().invalidate(level);
+
+        addParticleWork(ParallelDescriptor::second() - strt_time);
     }
 #endif
     //
@@ -393,6 +407,7 @@ Real
 NavierStokes::predict_velocity (Real  dt)
 {
     BL_PROFILE("NavierStokes::predict_velocity()");
+    NS_STEP_PHASE("predict_velocity");
 
     if (verbose) Print() << "... predict edge velocities\n";
     //
@@ -443,6 +458,10 @@ NavierStokes::predict_velocity (Real  dt)
     FillPatchIterator S_fpi(*this,visc_terms,1,prev_time,State_Type,Density,NUM_SCALARS);
     MultiFab& Smf=S_fpi.get_mf();
 
+    MemoryAccount::Tag adv_tag(theMemoryAccount(), level, MemoryAccount::GodunovWork,
+                               MemoryAccount::bytes(visc_terms) + MemoryAccount::bytes(Gp) +
+                               MemoryAccount::bytes(Umf) + MemoryAccount::bytes(Smf));
+
     //
     // Compute "grid cfl number" based on cell-centered time-n velocities
     //
@@ -499,6 +518,7 @@ NavierStokes::scalar_advection (Real dt,
                                 int  lscalar)
 {
     BL_PROFILE("NavierStokes::scalar_advection()");
+    NS_STEP_PHASE("scalar_advection");
 
     if (verbose) Print() << "... advect scalars\n";
     //
@@ -526,11 +546,16 @@ NavierStokes::scalar_advection (Real dt,
 
     MultiFab fluxes[BL_SPACEDIM];
     //MultiFab edgstate[BL_SPACEDIM];
+    long nflux = 0;
     for (int i = 0; i < BL_SPACEDIM; i++) {
       const BoxArray& ba = getEdgeBoxArray(i);
       fluxes[i].define(ba, dmap, num_scalars, 0);
       //edgstate[i].define(ba, dmap, num_scalars, 0);
+      nflux += MemoryAccount::bytes(fluxes[i]);
     }
+    MemoryAccount::Tag flux_tag(theMemoryAccount(), level, MemoryAccount::Fluxes, nflux);
+    MemoryAccount::Tag adv_tag(theMemoryAccount(), level, MemoryAccount::GodunovWork,
+                               MemoryAccount::bytes(visc_terms) + MemoryAccount::bytes(*divu_fp));
 
     //
     // Compute the advective forcing.
@@ -557,6 +582,9 @@ NavierStokes::scalar_advection (Real dt,
 
       FillPatchIterator U_fpi(*this,visc_terms,Godunov::hypgrow(),prev_time,State_Type,Xvel,BL_SPACEDIM);
       const MultiFab& Umf=U_fpi.get_mf();
+
+      adv_tag.grow(MemoryAccount::bytes(visc_terms) + MemoryAccount::bytes(*divu_fp) +
+                   MemoryAccount::bytes(Smf) + MemoryAccount::bytes(Umf));
       
 #ifdef _OPENMP
 #pragma omp parallel
@@ -567,10 +595,12 @@ NavierStokes::scalar_advection (Real dt,
       FArrayBox tforces;
       FArrayBox cfluxes[BL_SPACEDIM];
       FArrayBox edgstate[BL_SPACEDIM];
+      MemoryAccount::Tag work_tag(theMemoryAccount(), level, MemoryAccount::GodunovWork);
      
       for (MFIter S_mfi(Smf,true); S_mfi.isValid(); ++S_mfi)
       {
 	    const Box bx = S_mfi.tilebox();
+	    const Real strt_time = ParallelDescriptor::second();
 
 	      if (getForceVerbose) {
 	        Print() << "---" << '\n' << "C - scalar advection:" << '\n' 
@@ -578,12 +608,15 @@ NavierStokes::scalar_advection (Real dt,
 	      }
         getForce(tforces,bx,nGrowF,fscalar,num_scalars,prev_time,Umf[S_mfi],Smf[S_mfi],0);
 
+        long work_bytes = tforces.nBytes();
         for (int d=0; d<BL_SPACEDIM; ++d)
         {
           const Box& ebx = surroundingNodes(bx,d);
           cfluxes[d].resize(ebx,num_scalars);
           edgstate[d].resize(ebx,num_scalars);
+          work_bytes += cfluxes[d].nBytes() + edgstate[d].nBytes();
         }
+        work_tag.grow(work_bytes);
 
         for (int i=0; i<num_scalars; ++i) { // FIXME: Loop rqd b/c function does not take array conserv_diff
           int use_conserv_diff = (advectionType[fscalar+i] == Conservative) ? 1 : 0;
@@ -607,6 +640,8 @@ NavierStokes::scalar_advection (Real dt,
           const Box& ebx = S_mfi.nodaltilebox(d);
           (fluxes[d])[S_mfi].copy(cfluxes[d],ebx,0,ebx,0,num_scalars);
         }
+
+        addWork(S_mfi, ParallelDescriptor::second() - strt_time);
       }
     }
 }
@@ -623,9 +658,8 @@ NavierStokes::scalar_advection (Real dt,
 	}
       if (level < parent->finestLevel())
 	{
-	  //Print()<<"doing CrseInit..\n";
 	  for (int i = 0; i < BL_SPACEDIM; i++)
-	    getAdvFluxReg(level+1).CrseInit(fluxes[i],i,0,fscalar,num_scalars,-dt);
+	    stageCrseFlux(AdvFluxReg,fluxes[i],i,0,fscalar,num_scalars,-dt);
 	}
     }
 }
@@ -647,6 +681,7 @@ NavierStokes::scalar_update (Real dt,
                              int  last_scalar)
 {
     BL_PROFILE("NavierStokes::scalar_update()");
+    NS_STEP_PHASE("scalar_update");
 
     if (verbose) Print() << "... update scalars\n";
 
@@ -677,76 +712,104 @@ NavierStokes::scalar_diffusion_update (Real dt,
 {
     BL_PROFILE("NavierStokes::scalar_diffusion_update()");
 
-    FluxBoxes fb_SCn  (this);
-    FluxBoxes fb_SCnp1(this);
-
-    MultiFab** fluxSCn   = fb_SCn.get();
-    MultiFab** fluxSCnp1 = fb_SCnp1.get();
-
     const MultiFab& Rh = get_rho_half_time();
-
+    //
+    // With constant coefficients the scalars that share visc_coef, rho_flag
+    // and the domain BCs are diffused together, with one operator.
+    //
+    Vector<int> comps, rho_flags;
     for (int sigma = first_scalar; sigma <= last_scalar; sigma++)
     {
         if (is_diffusive[sigma])
         {
-            int        rho_flag    = 0;
-            MultiFab*  delta_rhs   = 0;
-            MultiFab*  alpha       = 0;
-            MultiFab** cmp_diffn   = 0;
-            MultiFab** cmp_diffnp1 = 0;
+            int rho_flag = 0;
+            diffuse_scalar_setup(sigma, rho_flag);
+            comps.push_back(sigma);
+            rho_flags.push_back(rho_flag);
+        }
+    }
 
-	    FluxBoxes fb_diffn, fb_diffnp1;
+    Vector< Vector<int> > groups;
+    if (variable_scal_diff)
+    {
+        for (int i = 0; i < comps.size(); i++)
+            groups.push_back(Vector<int>(1,comps[i]));
+    }
+    else
+    {
+        diffusion->groupScalars(comps, rho_flags, groups);
+    }
 
-            if (variable_scal_diff)
-            {
-                Real diffTime = state[State_Type].prevTime();
-		cmp_diffn = fb_diffn.define(this);
-                getDiffusivity(cmp_diffn, diffTime, sigma, 0, 1);
+    for (int g = 0; g < groups.size(); g++)
+    {
+        const Vector<int>& sigmas = groups[g];
+        const int          nscal  = sigmas.size();
+        int                rho_flag = 0;
 
-                diffTime = state[State_Type].curTime();
-		cmp_diffnp1 = fb_diffnp1.define(this);
-                getDiffusivity(cmp_diffnp1, diffTime, sigma, 0, 1);
-            }
+        diffuse_scalar_setup(sigmas[0], rho_flag);
 
-            diffuse_scalar_setup(sigma, rho_flag);
+        FluxBoxes fb_SCn  (this, theMemoryAccount(), nscal);
+        FluxBoxes fb_SCnp1(this, theMemoryAccount(), nscal);
+
+        MultiFab** fluxSCn   = fb_SCn.get();
+        MultiFab** fluxSCnp1 = fb_SCnp1.get();
+
+        if (variable_scal_diff)
+        {
+            const int sigma = sigmas[0];
+
+            FluxBoxes fb_diffn, fb_diffnp1;
+
+            Real diffTime = state[State_Type].prevTime();
+            MultiFab** cmp_diffn = fb_diffn.define(this, theMemoryAccount());
+            getDiffusivity(cmp_diffn, diffTime, sigma, 0, 1);
+
+            diffTime = state[State_Type].curTime();
+            MultiFab** cmp_diffnp1 = fb_diffnp1.define(this, theMemoryAccount());
+            getDiffusivity(cmp_diffnp1, diffTime, sigma, 0, 1);
 
             const int betaComp = 0, rhsComp = 0, alphaComp = 0, fluxComp  = 0;
 
             diffusion->diffuse_scalar(dt,sigma,be_cn_theta,Rh,
-                                      rho_flag,fluxSCn,fluxSCnp1,fluxComp,delta_rhs,
-                                      rhsComp,alpha,alphaComp,cmp_diffn,cmp_diffnp1,betaComp);
-
-            delete delta_rhs;
-            delete alpha;
-            //
-            // Increment the viscous flux registers
-            //
-            if (do_reflux)
+                                      rho_flag,fluxSCn,fluxSCnp1,fluxComp,0,
+                                      rhsComp,0,alphaComp,cmp_diffn,cmp_diffnp1,betaComp);
+        }
+        else
+        {
+            diffusion->diffuse_scalars(dt,sigmas,be_cn_theta,Rh,rho_flag,
+                                       fluxSCn,fluxSCnp1,0);
+        }
+        //
+        // Increment the viscous flux registers
+        //
+        if (do_reflux)
+        {
+            for (int d = 0; d < BL_SPACEDIM; d++)
             {
-                for (int d = 0; d < BL_SPACEDIM; d++)
-                {
-                    MultiFab fluxes;
+                MultiFab fluxes;
 
-		    fluxes.define(fluxSCn[d]->boxArray(), fluxSCn[d]->DistributionMap(), 1, 0);
+                fluxes.define(fluxSCn[d]->boxArray(), fluxSCn[d]->DistributionMap(), nscal, 0);
 
-		    {
+                {
 #ifdef _OPENMP
 #pragma omp parallel
 #endif	      
-                    for (MFIter fmfi(*fluxSCn[d],true); fmfi.isValid(); ++fmfi)
-		    {
-                        const Box& ebox = fmfi.tilebox();
-
-                        fluxes[fmfi].copy((*fluxSCn[d])[fmfi],ebox,0,ebox,0,1);
-                        fluxes[fmfi].plus((*fluxSCnp1[d])[fmfi],ebox,ebox,0,0,1);
-                    }
-		    }
-		    
-		    if (level > 0)
-		      getViscFluxReg().FineAdd(fluxes,d,0,sigma,1,dt);
+                for (MFIter fmfi(*fluxSCn[d],true); fmfi.isValid(); ++fmfi)
+                {
+                    const Box& ebox = fmfi.tilebox();
+
+                    fluxes[fmfi].copy((*fluxSCn[d])[fmfi],ebox,0,ebox,0,nscal);
+                    fluxes[fmfi].plus((*fluxSCnp1[d])[fmfi],ebox,ebox,0,0,nscal);
+                }
+                }
+
+                for (int i = 0; i < nscal; i++)
+                {
+                    if (level > 0)
+                        getViscFluxReg().FineAdd(fluxes,d,i,sigmas[i],1,dt);
 
                     if (level < parent->finestLevel())
-                        getLevel(level+1).getViscFluxReg().CrseInit(fluxes,d,0,sigma,1,-dt);
+                        stageCrseFlux(ViscFluxReg,fluxes,d,i,sigmas[i],1,-dt);
                 }
             }
         }
@@ -768,10 +831,12 @@ NavierStokes::velocity_diffusion_update (Real dt)
         int rho_flag = (do_mom_diff == 0) ? 1 : 3;
 
         MultiFab* delta_rhs = 0;
+        MemoryAccount::Tag rhs_tag(theMemoryAccount(), level, MemoryAccount::SolverWork);
         if (S_in_vel_diffusion && have_divu)
         {
             delta_rhs = new MultiFab(grids,dmap,BL_SPACEDIM,0);
             delta_rhs->setVal(0);
+            rhs_tag.grow(MemoryAccount::bytes(*delta_rhs));
         }
 
         MultiFab** loc_viscn   = 0;
@@ -781,11 +846,11 @@ NavierStokes::velocity_diffusion_update (Real dt)
         if (variable_vel_visc)
         {
             Real viscTime = state[State_Type].prevTime();
-	    loc_viscn = fb_viscn.define(this);
+	    loc_viscn = fb_viscn.define(this, theMemoryAccount());
             getViscosity(loc_viscn, viscTime);
 
             viscTime = state[State_Type].curTime();
-	    loc_viscnp1 = fb_viscnp1.define(this);
+	    loc_viscnp1 = fb_viscnp1.define(this, theMemoryAccount());
             getViscosity(loc_viscnp1, viscTime);
         }
 
@@ -837,6 +902,8 @@ NavierStokes::diffuse_velocity_setup (Real       dt,
         const Real time = state[State_Type].prevTime();
 
         MultiFab divmusi(grids,dmap,BL_SPACEDIM,0);
+        MemoryAccount::Tag work_tag(theMemoryAccount(), level, MemoryAccount::SolverWork,
+                                    MemoryAccount::bytes(divmusi));
 
         if (!variable_vel_visc)
         {
@@ -863,53 +930,14 @@ Real
 NavierStokes::MaxVal (const std::string& name,
                       Real           time)
 {
-    Real        mxval = 0.0;
-    auto        mf = derive(name,time,0);
-    BoxArray    baf;
-
-    if (level < parent->finestLevel())
-    {
-        baf = parent->boxArray(level+1);
-        baf.coarsen(fine_ratio);
-    }
-
-    //Add and test this OMP
-    //#ifdef _OPENMP
-    //#pragma omp parallel if (!system::regtest_reduction) reduction(max:mxval,s)
-    //#endif
-    //{
-
-    std::vector< std::pair<int,Box> > isects;
-
-    for (MFIter mfi(*mf); mfi.isValid(); ++mfi)
-    {
-        const int  i   = mfi.index();
-        FArrayBox& fab = (*mf)[mfi];
+    Vector<std::string> sum_names, max_names(1,name);
+    Vector<Real>        sums, maxs(1,0.0);
 
-        if (level < parent->finestLevel())
-        {
-            baf.intersections(grids[i],isects);
-
-            for (int ii = 0, N = isects.size(); ii < N; ii++)
-                fab.setVal(0,isects[ii].second,0,fab.nComp());
-        }
-        Real        s;
-        const Real* dat = fab.dataPtr();
-        const int*  dlo = fab.loVect();
-        const int*  dhi = fab.hiVect();
-	const Box&  bx  = grids[i];
-        const int*  lo  = bx.loVect();
-        const int*  hi  = bx.hiVect();
-
-        fort_maxval(dat,ARLIM(dlo),ARLIM(dhi),ARLIM(lo),ARLIM(hi),&s);
+    integrals(sum_names,max_names,time,sums,maxs);
 
-        mxval = std::max(mxval, s);
-    }
-    //} end OMP parallel
-
-    ParallelDescriptor::ReduceRealMax(mxval);
+    ParallelDescriptor::ReduceRealMax(maxs[0]);
 
-    return mxval;
+    return maxs[0];
 }
 
 void
@@ -918,35 +946,45 @@ NavierStokes::sum_integrated_quantities ()
     const int finest_level = parent->finestLevel();
 
     Real time = state[State_Type].curTime();
-    // Real mass = 0.0;
-    // Real trac = 0.0;
-    Real energy = 0.0;
-    Real mgvort = 0.0;
+    //
+    // All quantities are evaluated in one pass per level and
+    // reduced across ranks together at the end.
+    //
+    Vector<std::string> sum_names, max_names;
+
+    // sum_names.push_back("density");
+    // sum_names.push_back("tracer");
+    sum_names.push_back("energy");
 #if defined(DO_IAMR_FORCE)
-    Real forcing = 0.0;
+    sum_names.push_back("forcing");
 #endif
 #if (BL_SPACEDIM==3)
-    Real udotlapu = 0.0;
+    sum_names.push_back("udotlapu");
 #endif
+    max_names.push_back("mag_vort");
+
+    Vector<Real> sums(sum_names.size(),0.0);
+    Vector<Real> maxs(max_names.size(),0.0);
 
     for (int lev = 0; lev <= finest_level; lev++)
     {
-        NavierStokes& ns_level = getLevel(lev);
-        // mass += ns_level.volWgtSum("density",time);
-        // trac += ns_level.volWgtSum("tracer",time);
-        energy += ns_level.volWgtSum("energy",time);
-        mgvort = std::max(mgvort,ns_level.MaxVal("mag_vort",time));
+        getLevel(lev).integrals(sum_names,max_names,time,sums,maxs);
+    }
+
+    ParallelDescriptor::ReduceRealSum(sums.dataPtr(),sums.size());
+    ParallelDescriptor::ReduceRealMax(maxs.dataPtr(),maxs.size());
+
+    int q = 0;
+    const Real energy = sums[q++];
 #if defined(DO_IAMR_FORCE)
-        forcing += ns_level.volWgtSum("forcing",time);
+    const Real forcing = sums[q++];
 #endif
 #if (BL_SPACEDIM==3)
-        udotlapu += ns_level.volWgtSum("udotlapu",time);
+    const Real udotlapu = sums[q++];
 #endif
-    }
+    const Real mgvort = maxs[0];
 
     Print() << '\n';
-    // Print().SetPrecision(12) << "TIME= " << time << " MASS= " << mass << '\n';
-    // Print().SetPrecision(12) << "TIME= " << time << " TRAC= " << trac << '\n';
     Print().SetPrecision(12) << "TIME= " << time << " KENG= " << energy << '\n';
     Print().SetPrecision(12) << "TIME= " << time << " MAGVORT= " << mgvort << '\n';
     Print().SetPrecision(12) << "TIME= " << time << " ENERGY= " << energy << '\n';
@@ -1006,6 +1044,11 @@ NavierStokes::writePlotFile (const std::string& dir,
 
     int n_data_items = plot_var_map.size() + num_derive;
     Real cur_time = state[State_Type].curTime();
+    //
+    // The memory use goes into the job_info file.
+    //
+    if (level == 0)
+        theMemoryAccount().reduce();
 
     if (level == 0 && ParallelDescriptor::IOProcessor())
     {
@@ -1145,6 +1188,15 @@ NavierStokes::writePlotFile (const std::string& dir,
 	
 	ParmParse::dumpTable(jobInfoFile, true);
 
+	jobInfoFile << "\n\n";
+
+	// memory use
+	jobInfoFile << PrettyLine;
+	jobInfoFile << " Memory Use\n";
+	jobInfoFile << PrettyLine;
+
+	theMemoryAccount().print(jobInfoFile);
+
 	jobInfoFile.close();
 	
     }
@@ -1335,6 +1387,11 @@ NavierStokes::post_init (Real stop_time)
         sum_jet_quantities();
 #endif
 #endif
+    //
+    // Don't report the initial iterations as part of the first step.
+    //
+    theStepTimer().clear();
+    SolverStats::clear();
 }
 
 //
@@ -1420,6 +1477,7 @@ NavierStokes::mac_sync ()
 {
     BL_PROFILE_REGION_START("R::NavierStokes::mac_sync()");
     BL_PROFILE("NavierStokes::mac_sync()");
+    NS_STEP_PHASE("mac_sync");
 
     const int  numscal        = NUM_STATE - BL_SPACEDIM;
     const Real prev_time      = state[State_Type].prevTime();
@@ -1516,53 +1574,77 @@ NavierStokes::mac_sync ()
             if (variable_vel_visc)
             {
                 Real viscTime = state[State_Type].prevTime();
-		loc_viscn = fb_viscn.define(this);
+		loc_viscn = fb_viscn.define(this, theMemoryAccount());
                 getViscosity(loc_viscn, viscTime);
             }
 
             diffusion->diffuse_Vsync(Vsync,dt,be_cn_theta,Rh,rho_flag,loc_viscn,0);
         }
 
-	FluxBoxes fb_SC;
-        MultiFab** fluxSC        = 0;
-        bool       any_diffusive = false;
-        for (int sigma  = 0; sigma < numscal; sigma++)
-            if (is_diffusive[BL_SPACEDIM+sigma])
-                any_diffusive = true;
-
-        if (any_diffusive) {
-	    fluxSC = fb_SC.define(this);
-	}
-
+        //
+        // With constant coefficients the scalars that share visc_coef,
+        // rho_flag and the domain BCs are solved together, with one operator.
+        //
+        Vector<int> comps, rho_flags;
         for (int sigma = 0; sigma<numscal; sigma++)
         {
             const int state_ind = BL_SPACEDIM + sigma;
-            const int rho_flag  = Diffusion::set_rho_flag(diffusionType[state_ind]);
 
             if (is_diffusive[state_ind])
             {
-		FluxBoxes fb_diffn;
-                MultiFab** cmp_diffn=0;
+                comps.push_back(state_ind);
+                rho_flags.push_back(Diffusion::set_rho_flag(diffusionType[state_ind]));
+            }
+        }
 
-                if (variable_scal_diff)
-                {
-                    Real diffTime = state[State_Type].prevTime();
-		    cmp_diffn = fb_diffn.define(this);
-                    getDiffusivity(cmp_diffn, diffTime, BL_SPACEDIM+sigma,0,1);
-                }
+        Vector< Vector<int> > groups;
+        if (variable_scal_diff)
+        {
+            for (int i = 0; i < comps.size(); i++)
+                groups.push_back(Vector<int>(1,comps[i]));
+        }
+        else
+        {
+            diffusion->groupScalars(comps, rho_flags, groups);
+        }
 
-                diffusion->diffuse_Ssync(Ssync,sigma,dt,be_cn_theta,
-                                         Rh,rho_flag,fluxSC,0,cmp_diffn,0,0,0);
+        for (int g = 0; g < groups.size(); g++)
+        {
+            const int   nscal    = groups[g].size();
+            const int   rho_flag = Diffusion::set_rho_flag(diffusionType[groups[g][0]]);
+            Vector<int> sigmas(nscal);
+
+            for (int i = 0; i < nscal; i++)
+                sigmas[i] = groups[g][i] - BL_SPACEDIM;
+
+            FluxBoxes  fb_SC(this, theMemoryAccount(), nscal);
+            MultiFab** fluxSC = fb_SC.get();
+
+            if (variable_scal_diff)
+            {
+                FluxBoxes fb_diffn;
+
+                Real diffTime = state[State_Type].prevTime();
+                MultiFab** cmp_diffn = fb_diffn.define(this, theMemoryAccount());
+                getDiffusivity(cmp_diffn, diffTime, groups[g][0],0,1);
 
-                //
-                // Increment the viscous flux registers
-                //
-                if (level > 0)
+                diffusion->diffuse_Ssync(Ssync,sigmas[0],dt,be_cn_theta,
+                                         Rh,rho_flag,fluxSC,0,cmp_diffn,0,0,0);
+            }
+            else
+            {
+                diffusion->diffuse_Ssync(Ssync,sigmas,dt,be_cn_theta,
+                                         Rh,rho_flag,fluxSC,0);
+            }
+            //
+            // Increment the viscous flux registers
+            //
+            if (level > 0)
+            {
+                for (int d = 0; d < BL_SPACEDIM; d++)
                 {
-                    for (int d = 0; d < BL_SPACEDIM; d++)
-                    {
-                        getViscFluxReg().FineAdd(*fluxSC[d],d,0,state_ind,1,dt);
-                    }
+                    for (int i = 0; i < nscal; i++)
+                        getViscFluxReg().FineAdd(*fluxSC[d],d,i,groups[g][i],1,dt);
                 }
             }
         }
@@ -1634,6 +1716,8 @@ NavierStokes::mac_sync ()
             NavierStokes&     fine_lev = getLevel(lev);
             const BoxArray& fine_grids = fine_lev.boxArray();
             MultiFab sync_incr(fine_grids,fine_lev.DistributionMap(),numscal,0);
+            MemoryAccount::Tag work_tag(theMemoryAccount(), lev, MemoryAccount::SolverWork,
+                                        MemoryAccount::bytes(sync_incr));
             sync_incr.setVal(0.0);
 
             SyncInterp(Ssync,level,sync_incr,lev,ratio,0,0,
@@ -1668,6 +1752,7 @@ NavierStokes::reflux ()
         return;
 
     BL_PROFILE("NavierStokes::reflux()");
+    NS_STEP_PHASE("reflux");
 
     BL_ASSERT(do_reflux);
     //
@@ -1794,6 +1879,8 @@ NavierStokes::avgDown ()
     if (level == parent->finestLevel())
         return;
 
+    NS_STEP_PHASE("avgDown");
+
     NavierStokes&   crse_lev = getLevel(level  );
     NavierStokes&   fine_lev = getLevel(level+1);
     //
@@ -1972,7 +2059,7 @@ NavierStokes::getViscTerms (MultiFab& visc_terms,
 
         if (variable_vel_visc)
         {
-	    viscosity = fb.define(this);
+	    viscosity = fb.define(this, theMemoryAccount());
             getViscosity(viscosity, time);
 
             diffusion->getTensorViscTerms(visc_terms,time,viscosity,0);
@@ -1994,6 +2081,8 @@ NavierStokes::getViscTerms (MultiFab& visc_terms,
         if (have_divu && S_in_vel_diffusion)
         {
             MultiFab divmusi(grids,dmap,BL_SPACEDIM,1);
+            MemoryAccount::Tag work_tag(theMemoryAccount(), level, MemoryAccount::SolverWork,
+                                        MemoryAccount::bytes(divmusi));
 
             if (variable_vel_visc)
             {
@@ -2030,7 +2119,7 @@ NavierStokes::getViscTerms (MultiFab& visc_terms,
 
                 if (variable_scal_diff)
                 {
-		    cmp_diffn = fb.define(this);
+		    cmp_diffn = fb.define(this, theMemoryAccount());
                     getDiffusivity(cmp_diffn, time, icomp, 0, 1);
                 }
 
@@ -1,10 +1,23 @@
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <sstream>
+
 #include <AMReX_ParmParse.H>
 #include <AMReX_TagBox.H>
 #include <AMReX_Utility.H>
 
 #include <NavierStokesBase.H>
 #include <NAVIERSTOKES_F.H>
+#include <SLABSTAT_NS_F.H>
+#include <PlaneWriter.H>
+#include <TurbStats.H>
+#include <TimestampWriter.H>
+#include <ParticleReader.H>
+#include <SolverStats.H>
+#include <NS_interp.H>
 
 #include <PROB_NS_F.H> 
 
@@ -73,6 +86,7 @@ int         NavierStokesBase::do_vorticity_ref          = 0;
 int         NavierStokesBase::do_temp_ref               = 0;
 int         NavierStokesBase::do_scalar_update_in_order = 0; 
 Vector<int>  NavierStokesBase::scalarUpdateOrder;
+int         NavierStokesBase::scalar_update_tasks       = 0;
 int         NavierStokesBase::getForceVerbose           = 0;
 
 int  NavierStokesBase::Dpdt_Type = -1;
@@ -80,6 +94,8 @@ int  NavierStokesBase::Dpdt_Type = -1;
 int  NavierStokesBase::additional_state_types_initialized = 0;
 int  NavierStokesBase::Divu_Type                          = -1;
 int  NavierStokesBase::Dsdt_Type                          = -1;
+int  NavierStokesBase::Stats_Type                         = -1;
+int  NavierStokesBase::Work_Type                          = -1;
 int  NavierStokesBase::num_state_type                     = 2;
 int  NavierStokesBase::have_divu                          = 0;
 int  NavierStokesBase::have_dsdt                          = 0;
@@ -89,6 +105,13 @@ int  NavierStokesBase::do_init_vort_proj                  = 0;
 int  NavierStokesBase::do_init_proj                       = 1;
 
 int  NavierStokesBase::do_running_statistics  = 0;
+int  NavierStokesBase::running_statistics_interval = 1;
+int  NavierStokesBase::do_work_estimates      = 0;
+Real NavierStokesBase::work_estimate_decay    = 0.5;
+Real NavierStokesBase::load_balance_threshold = 0.1;
+Real NavierStokesBase::particle_work_weight   = 1.0;
+int  NavierStokesBase::delta_chk              = 0;
+int  NavierStokesBase::delta_chk_full_int     = 4;
 Real NavierStokesBase::volWgtSum_sub_origin_x = 0;
 Real NavierStokesBase::volWgtSum_sub_origin_y = 0;
 Real NavierStokesBase::volWgtSum_sub_origin_z = 0;
@@ -106,9 +129,65 @@ namespace
     bool initialized = false;
     int  dump_plane  = -1;
     std::string dump_plane_name("SLABS/vel-");
+    Vector<int> dump_plane_dir;
+    Vector<int> dump_plane_loc;
+    Vector<int> dump_plane_comps;
+    int  dump_plane_buffer = 1;
+    int  dump_plane_chunk  = 64;
+    //
+    // One writer per plane, built at the first level-0 post_timestep.
+    //
+    Vector<PlaneWriter*> plane_writers;
+    //
+    // Running turbulence statistics, held by the IOProcessor.
+    //
+    int  turb_stats         = 1;
+    int  turb_ascii         = 0;
+    int  turb_stats_moments = 2;
+    int  turb_stats_flush   = 10;
+    std::string turb_stats_file("TurbData/TurbStats.bin");
+    TurbStatsAccumulator* turb_acc = 0;
+    //
+    // One line of JSON per coarse step with the times of its phases.
+    //
+    int         step_timing = 0;
+    std::string step_timing_file("StepTiming.json");
+    StepTimer   step_timer;
+    //
+    // Bytes held by each level; printed after every regrid if memory_report.
+    //
+    MemoryAccount mem_account;
+    int           memory_report = 1;
     bool benchmarking = false;
+    //
+    // What SyncInterp() and SyncProjInterp() derive from the grids alone,
+    // kept from call to call until the grids change at regrid.  The coarse
+    // data MultiFab is kept as well: AMReX drops its cached copy plans with
+    // the last FabArray on a BoxArray and DistributionMapping, so only a
+    // MultiFab that outlives the call lets the next copy reuse them.
+    //
+    struct SyncCrseData
+    {
+        BoxArray                  fba;
+        BoxArray                  cba;
+        std::unique_ptr<MultiFab> cmf;
+    };
+
+    struct SyncBCGrids
+    {
+        BoxArray cgrids;
+        Box      cdomain;
+        int      grid[2*BL_SPACEDIM];
+    };
+
+    std::map<std::pair<std::pair<int,int>,const Interpolater*>,SyncCrseData> sync_crse_data;
+    std::map<int,SyncBCGrids>                                                 sync_bc_grids;
 }
 
+StepTimer& NavierStokesBase::theStepTimer () { return step_timer; }
+
+MemoryAccount& NavierStokesBase::theMemoryAccount () { return mem_account; }
+
 #ifdef AMREX_PARTICLES
 namespace
 {
@@ -123,14 +202,46 @@ namespace
 
     std::string      timestamp_dir                   ("Timestamps");
     std::vector<int> timestamp_indices;
+    int              timestamp_binary                = 1;
+    int              timestamp_buffer                = 16; // MB
+    TimestampWriter* timestamp_writer                = 0;
     std::string      particle_init_file;
     std::string      particle_restart_file;
     std::string      particle_output_file;
+    int              particle_init_readers           = 0;
+    //
+    // Sort the particles of a level by cell every this many of its steps.
+    //
+    int              particle_sort_int               = 0;
+    ParticleSorter   particle_sorter;
     bool             restart_from_nonparticle_chkfile = false;
     int              pverbose                         = 2;
 }
 
 AmrTracerParticleContainer* NavierStokesBase::theNSPC () { return NSPC; }
+
+ParticleSorter& NavierStokesBase::theParticleSorter () { return particle_sorter; }
+
+namespace
+{
+    //
+    // Read particles from a binary file in parallel, or from an ASCII file.
+    //
+    void
+    init_particles_from_file (const std::string& file)
+    {
+        if (ParticleReader::isBinary(file))
+        {
+            const int nreaders = (particle_init_readers > 0) ? particle_init_readers
+                                                             : ParallelDescriptor::NProcs();
+            ParticleReader::initFromBinaryFile(*NSPC, file, nreaders);
+        }
+        else
+        {
+            NSPC->InitFromAsciiFile(file,0);
+        }
+    }
+}
 #endif
 
 int NavierStokesBase::DoTrac2() {return NavierStokesBase::do_trac2;}
@@ -310,13 +421,28 @@ NavierStokesBase::variableCleanUp ()
 
     err_list.clear();
 
+    for (int i = 0; i < plane_writers.size(); i++)
+        delete plane_writers[i];
+    plane_writers.clear();
+
+    if (turb_acc != 0 && turb_acc->pending() > 0)
+        turb_acc->write(turb_stats_file);
+    delete turb_acc;
+    turb_acc = 0;
+
     delete projector;
     projector = 0;
 
     delete mac_projector;
     mac_projector = 0;
 
+    sync_crse_data.clear();
+    sync_bc_grids.clear();
+
 #ifdef AMREX_PARTICLES
+    delete timestamp_writer;
+    timestamp_writer = 0;
+
     delete NSPC;
     NSPC = 0;
 #endif
@@ -330,6 +456,42 @@ NavierStokesBase::Initialize ()
     ParmParse pp("ns");
 
     pp.query("dump_plane",dump_plane);
+    //
+    // Additional planes are given by their normal direction and index.
+    //
+    const int n_dump_plane_dir = pp.countval("dump_plane_dir");
+    if (n_dump_plane_dir > 0)
+    {
+        pp.getarr("dump_plane_dir",dump_plane_dir,0,n_dump_plane_dir);
+        pp.getarr("dump_plane_loc",dump_plane_loc,0,n_dump_plane_dir);
+    }
+    if (dump_plane >= 0)
+    {
+        dump_plane_dir.push_back(BL_SPACEDIM-1);
+        dump_plane_loc.push_back(dump_plane);
+    }
+    const int n_dump_plane_comps = pp.countval("dump_plane_comps");
+    if (n_dump_plane_comps > 0)
+    {
+        pp.getarr("dump_plane_comps",dump_plane_comps,0,n_dump_plane_comps);
+    }
+    else
+    {
+        for (int d = 0; d < BL_SPACEDIM; d++)
+            dump_plane_comps.push_back(Xvel+d);
+    }
+    pp.query("dump_plane_name",dump_plane_name);
+    pp.query("dump_plane_buffer",dump_plane_buffer);
+    pp.query("dump_plane_chunk",dump_plane_chunk);
+
+    pp.query("turb_stats",turb_stats);
+    pp.query("turb_ascii",turb_ascii);
+    pp.query("turb_stats_moments",turb_stats_moments);
+    pp.query("turb_stats_flush",turb_stats_flush);
+    pp.query("turb_stats_file",turb_stats_file);
+    if (!turb_stats) turb_ascii = 1;
+    turb_stats_moments = std::max(1,std::min(turb_stats_moments,4));
+    turb_stats_flush   = std::max(1,turb_stats_flush);
 
     pp.query("benchmarking",benchmarking);
 
@@ -451,6 +613,7 @@ NavierStokesBase::Initialize ()
 	scalarUpdateOrder.resize(n_scalar_update_order_vals);
 	int got_scalar_update_order = pp.queryarr("scalar_update_order",scalarUpdateOrder,0,n_scalar_update_order_vals);
     }
+    pp.query("scalar_update_tasks",      scalar_update_tasks);
 
     // Don't let init_shrink be greater than 1
     if (init_shrink > 1.0)
@@ -552,6 +715,32 @@ NavierStokesBase::Initialize ()
     // Check whether we are doing running statistics.
     //
     pp.query("do_running_statistics",do_running_statistics);
+    pp.query("running_statistics_interval",running_statistics_interval);
+    running_statistics_interval = std::max(1,running_statistics_interval);
+    //
+    // Per-cell work measured in the advection and sync kernels; used by
+    // remapByWork() at regrid, with amr.loadbalance_with_workestimates
+    // left at 0 so that Amr does not remap by it as well.
+    //
+    pp.query("do_work_estimates",do_work_estimates);
+    pp.query("work_estimate_decay",work_estimate_decay);
+    pp.query("load_balance_threshold",load_balance_threshold);
+    pp.query("particle_work_weight",particle_work_weight);
+    work_estimate_decay = std::min(std::max(work_estimate_decay,Real(0)),Real(1));
+    //
+    // Always-on timing of the phases of advance and post_timestep.
+    //
+    pp.query("step_timing",step_timing);
+    pp.query("step_timing_file",step_timing_file);
+    step_timer.setActive(step_timing);
+
+    pp.query("memory_report",memory_report);
+    //
+    // Incremental checkpointing: only FABs changed since the last
+    // checkpoint are written, with a full checkpoint every delta_chk_full_int.
+    //
+    pp.query("delta_chk",delta_chk);
+    pp.query("delta_chk_full_int",delta_chk_full_int);
 
     // If dx,dy,dz,Rcyl<0 (default) the volWgtSum is computed over the entire domain
     pp.query("volWgtSum_sub_origin_x",volWgtSum_sub_origin_x);
@@ -680,6 +869,23 @@ NavierStokesBase::advance_setup (Real time,
     //
     for (int k = 0; k < num_state_type; k++)
     {
+        //
+        // The running statistics only have new data, which is added to.
+        //
+        if (k == Stats_Type)
+        {
+            state[k].setTimeLevel(time+dt,dt,dt);
+            continue;
+        }
+        //
+        // The work estimates are a decaying sum over the steps.
+        //
+        if (k == Work_Type)
+        {
+            state[k].setTimeLevel(time+dt,dt,dt);
+            get_new_data(Work_Type).mult(work_estimate_decay);
+            continue;
+        }
 	bool has_old_data = state[k].hasOldData();
         state[k].allocOldData();
 	if (! has_old_data) state[k].oldData().setVal(0.0);
@@ -760,10 +966,112 @@ NavierStokesBase::advance_setup (Real time,
 void
 NavierStokesBase::advance_cleanup (int iteration, int ncycle)
 {
+    //
+    // The data of the level is at its largest here.
+    //
+    account_memory();
+
+    flushCrseFluxes();
+
     delete aofs;
     aofs = 0;
 }
 
+void
+NavierStokesBase::stageCrseFlux (int             reg,
+                                 const MultiFab& flux,
+                                 int             dir,
+                                 int             scomp,
+                                 int             dcomp,
+                                 int             ncomp,
+                                 Real            mult)
+{
+    BL_ASSERT(reg >= 0 && reg < NumCrseFluxRegs);
+    BL_ASSERT(level < parent->finestLevel());
+
+    CrseFluxStage& stage = crse_flux_stage[reg][dir];
+
+    if (stage.staged.empty())
+    {
+        stage.staged.assign(NUM_STATE,0);
+        stage.mult.assign(NUM_STATE,0);
+    }
+    //
+    // The buffer covers the components staged in the last step; it is only
+    // reallocated when a call falls outside them.
+    //
+    const int lo = (stage.hi > stage.lo) ? std::min(stage.lo,dcomp)       : dcomp;
+    const int hi = (stage.hi > stage.lo) ? std::max(stage.hi,dcomp+ncomp) : dcomp+ncomp;
+
+    if (!stage.flux.ok() || lo < stage.lo || hi > stage.hi)
+    {
+        MultiFab grown(flux.boxArray(),flux.DistributionMap(),hi-lo,0);
+
+        if (stage.flux.ok())
+            MultiFab::Copy(grown,stage.flux,0,stage.lo-lo,stage.hi-stage.lo,0);
+
+        std::swap(stage.flux,grown);
+        stage.lo = lo;
+        stage.hi = hi;
+    }
+    //
+    // As in CrseInit, a later call overwrites the components.  The scaling
+    // is left to CrseInit.
+    //
+    MultiFab::Copy(stage.flux,flux,scomp,dcomp-stage.lo,ncomp,0);
+
+    for (int n = dcomp; n < dcomp+ncomp; n++)
+    {
+        stage.staged[n] = 1;
+        stage.mult[n]   = mult;
+    }
+}
+
+void
+NavierStokesBase::flushCrseFluxes ()
+{
+    if (level == parent->finestLevel())
+        return;
+
+    BL_PROFILE("NavierStokesBase::flushCrseFluxes()");
+
+    for (int reg = 0; reg < NumCrseFluxRegs; reg++)
+    {
+        FluxRegister& fr = (reg == AdvFluxReg) ? getAdvFluxReg(level+1)
+                                               : getViscFluxReg(level+1);
+
+        for (int dir = 0; dir < BL_SPACEDIM; dir++)
+        {
+            CrseFluxStage& stage = crse_flux_stage[reg][dir];
+
+            if (!stage.flux.ok())
+                continue;
+            //
+            // One CrseInit per run of components staged with the same mult,
+            // normally just one.
+            //
+            for (int n = stage.lo; n < stage.hi; )
+            {
+                if (!stage.staged[n]) { n++; continue; }
+
+                int m = n;
+                while (m < stage.hi && stage.staged[m] && stage.mult[m] == stage.mult[n])
+                    m++;
+
+                fr.CrseInit(stage.flux,dir,n-stage.lo,n,m-n,stage.mult[n]);
+
+                n = m;
+            }
+
+            std::fill(stage.staged.begin(),stage.staged.end(),0);
+            //
+            // Not held between the steps.
+            //
+            stage.flux.clear();
+        }
+    }
+}
+
 void
 NavierStokesBase::buildMetrics ()
 {
@@ -841,13 +1149,31 @@ NavierStokesBase::checkPoint (const std::string& dir,
 			      VisMF::How         how,
 			      bool               dump_old)
 {
-    AmrLevel::checkPoint(dir, os, how, dump_old);
+    if (delta_chk && delta_checkpoint.canWriteDelta(*this,dump_old,delta_chk_full_int))
+    {
+        delta_checkpoint.writeDelta(*this, dir, os, how, dump_old);
+    }
+    else
+    {
+        AmrLevel::checkPoint(dir, os, how, dump_old);
+
+        if (delta_chk)
+            delta_checkpoint.setBase(*this, dir, dump_old);
+    }
+
+    if (level == 0 && turb_acc != 0 && ParallelDescriptor::IOProcessor())
+        turb_acc->checkPoint(dir);
 
 #ifdef AMREX_PARTICLES
     if (level == 0)
     {
         if (NSPC != 0)
             NSPC->Checkpoint(dir,the_ns_particle_file_name);
+        //
+        // Make sure the timestamps are on disk up to the checkpoint.
+        //
+        if (timestamp_writer != 0)
+            timestamp_writer->flush();
     }
 #endif
 }
@@ -1036,90 +1362,87 @@ NavierStokesBase::create_umac_grown (int nGrow)
         c_bnd_ba.maxSize(32);
 
         f_bnd_ba = c_bnd_ba; f_bnd_ba.refine(crse_ratio);
+        //
+        // crse_src & fine_src must have same parallel distribution.
+        // We'll use the KnapSack distribution for the fine_src_ba.
+        // Since fine_src_ba should contain more points, this'll lead
+        // to a better distribution.  The faces of every direction follow
+        // the cells, so one distribution serves all the components of
+        // u_mac, and each kernel pass below handles all of them per box.
+        //
+        const int N = f_bnd_ba.size();
+
+        std::vector<long> wgts(N);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int i = 0; i < N; i++)
+            wgts[i] = f_bnd_ba[i].numPts();
+
+        DistributionMapping dm;
+        // This DM won't be put into the cache.
+        dm.KnapSackProcessorMap(wgts,ParallelDescriptor::NProcs());
+
+        MultiFab crse_src[BL_SPACEDIM], fine_src[BL_SPACEDIM];
 
         for (int n = 0; n < BL_SPACEDIM; ++n)
         {
-            //
-            // crse_src & fine_src must have same parallel distribution.
-            // We'll use the KnapSack distribution for the fine_src_ba.
-            // Since fine_src_ba should contain more points, this'll lead
-            // to a better distribution.
-            //
             BoxArray crse_src_ba(c_bnd_ba), fine_src_ba(f_bnd_ba);
 
             crse_src_ba.surroundingNodes(n);
             fine_src_ba.surroundingNodes(n);
 
-            const int N = fine_src_ba.size();
-
-            std::vector<long> wgts(N);
-
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for (int i = 0; i < N; i++)
-                wgts[i] = fine_src_ba[i].numPts();
-
-            DistributionMapping dm;
-            // This DM won't be put into the cache.
-            dm.KnapSackProcessorMap(wgts,ParallelDescriptor::NProcs());
+            crse_src[n].define(crse_src_ba, dm, 1, 0);
+            fine_src[n].define(fine_src_ba, dm, 1, 0);
 
-            MultiFab crse_src(crse_src_ba, dm, 1, 0);
-            MultiFab fine_src(fine_src_ba, dm, 1, 0);
-
-            crse_src.setVal(1.e200);
-            fine_src.setVal(1.e200);
+            crse_src[n].setVal(1.e200);
+            fine_src[n].setVal(1.e200);
             //
             // We want to fill crse_src from lower level u_mac including u_mac's grow cells.
             //
 	    const MultiFab& u_macLL = getLevel(level-1).u_mac[n];
-	    crse_src.copy(u_macLL,0,0,1,1,0);
+	    crse_src[n].copy(u_macLL,0,0,1,1,0);
+        }
 
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-            for (MFIter mfi(crse_src); mfi.isValid(); ++mfi)
-            {
-                const int  nComp = 1;
-                const Box& box   = crse_src[mfi].box();
-                const int* rat   = crse_ratio.getVect();
-                pc_edge_interp(box.loVect(), box.hiVect(), &nComp, rat, &n,
-                                       crse_src[mfi].dataPtr(),
-                                       ARLIM(crse_src[mfi].loVect()),
-                                       ARLIM(crse_src[mfi].hiVect()),
-                                       fine_src[mfi].dataPtr(),
-                                       ARLIM(fine_src[mfi].loVect()),
-                                       ARLIM(fine_src[mfi].hiVect()));
-            }
-            crse_src.clear();
-            //
-            // Replace pc-interpd fine data with preferred u_mac data at
-            // this level u_mac valid only on surrounding faces of valid
-            // region - this op will not fill grow region.
-            //
-            fine_src.copy(u_mac[n]);
-            //
-            // Interpolate unfilled grow cells using best data from
-            // surrounding faces of valid region, and pc-interpd data
-            // on fine edges overlaying coarse edges.
-            //
+        for (MFIter mfi(crse_src[0]); mfi.isValid(); ++mfi)
+        {
+            for (int n = 0; n < BL_SPACEDIM; ++n)
+                NSInterp::pc_edge_interp(crse_src[n][mfi].box(), 1, crse_ratio, n,
+                                         crse_src[n][mfi], fine_src[n][mfi]);
+        }
+        //
+        // Replace pc-interpd fine data with preferred u_mac data at
+        // this level u_mac valid only on surrounding faces of valid
+        // region - this op will not fill grow region.
+        //
+        for (int n = 0; n < BL_SPACEDIM; ++n)
+        {
+            crse_src[n].clear();
+            fine_src[n].copy(u_mac[n]);
+        }
+        //
+        // Interpolate unfilled grow cells using best data from
+        // surrounding faces of valid region, and pc-interpd data
+        // on fine edges overlaying coarse edges.
+        //
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-            for (MFIter mfi(fine_src); mfi.isValid(); ++mfi)
-            {
-                const int  nComp = 1;
-                const Box& fbox  = fine_src[mfi].box();
-                const int* rat   = crse_ratio.getVect();
-                edge_interp(fbox.loVect(), fbox.hiVect(), &nComp, rat, &n,
-                                 fine_src[mfi].dataPtr(),
-                                 ARLIM(fine_src[mfi].loVect()),
-                                 ARLIM(fine_src[mfi].hiVect()));
-            }
+        for (MFIter mfi(fine_src[0]); mfi.isValid(); ++mfi)
+        {
+            for (int n = 0; n < BL_SPACEDIM; ++n)
+                NSInterp::edge_interp(fine_src[n][mfi].box(), 1, crse_ratio, n, fine_src[n][mfi]);
+        }
 
+        for (int n = 0; n < BL_SPACEDIM; ++n)
+        {
 	    MultiFab u_mac_save(u_mac[n].boxArray(),u_mac[n].DistributionMap(), 1,0);
 	    u_mac_save.copy(u_mac[n]);
-	    u_mac[n].copy(fine_src,0,0,1,0,nGrow);
+	    u_mac[n].copy(fine_src[n],0,0,1,0,nGrow);
 	    u_mac[n].copy(u_mac_save);
         }
     }
@@ -1176,42 +1499,88 @@ NavierStokesBase::errorEst (TagBoxArray& tags,
 			    int          n_error_buf, 
 			    int          ngrow)
 {
+    BL_PROFILE("NavierStokesBase::errorEst()");
+
     const int*  domain_lo = geom.Domain().loVect();
     const int*  domain_hi = geom.Domain().hiVect();
     const Real* dx        = geom.CellSize();
     const Real* prob_lo   = geom.ProbLo();
+    const int   nerr      = err_list.size();
+
+    if (nerr == 0)
+        return;
+    //
+    // The criteria on components of State_Type share one FillPatch of the
+    // range of components they use; only the others need derive().
+    //
+    Vector<int> state_comp(nerr,-1);
+    int         scomp_lo = NUM_STATE, scomp_hi = -1, state_ngrow = 0;
+
+    for (int j = 0; j < nerr; j++)
+    {
+        int typ, comp;
+        if (isStateVariable(err_list[j].name(), typ, comp) && typ == State_Type)
+        {
+            state_comp[j] = comp;
+            scomp_lo      = std::min(scomp_lo, comp);
+            scomp_hi      = std::max(scomp_hi, comp);
+            state_ngrow   = std::max(state_ngrow, err_list[j].nGrow());
+        }
+    }
+
+    MultiFab S_err;
+    if (scomp_hi >= 0)
+    {
+        S_err.define(grids,dmap,scomp_hi-scomp_lo+1,state_ngrow);
+        FillPatch(*this,S_err,state_ngrow,time,State_Type,scomp_lo,S_err.nComp());
+    }
 
-    for (int j = 0; j < err_list.size(); j++)
+    Vector<std::unique_ptr<MultiFab> > derived(nerr);
+    for (int j = 0; j < nerr; j++)
     {
-        auto mf = derive(err_list[j].name(), time, err_list[j].nGrow());
+        if (state_comp[j] < 0)
+            derived[j] = derive(err_list[j].name(), time, err_list[j].nGrow());
+    }
+    //
+    // One pass over the tiles applies all the criteria to a single integer
+    // copy of the tags of the tile.
+    //
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-        for (MFIter mfi(*mf,true); mfi.isValid(); ++mfi)
+    {
+        Vector<int> itags;
+
+        for (MFIter mfi(tags,true); mfi.isValid(); ++mfi)
         {
-	          const Box&  vbx     = mfi.tilebox();
+            const Box&  vbx     = mfi.tilebox();
             RealBox     gridloc = RealBox(vbx,geom.CellSize(),geom.ProbLo());
-            Vector<int>  itags   = tags[mfi].tags();
-            int*        tptr    = itags.dataPtr();
-            const int*  tlo     = tags[mfi].box().loVect();
-            const int*  thi     = tags[mfi].box().hiVect();
             const int*  lo      = vbx.loVect();
             const int*  hi      = vbx.hiVect();
             const Real* xlo     = gridloc.lo();
-            FArrayBox&  fab     = (*mf)[mfi];
-            Real*       dat     = fab.dataPtr();
-            const int*  dlo     = fab.box().loVect();
-            const int*  dhi     = fab.box().hiVect();
-            const int   ncomp   = fab.nComp();
-
-            err_list[j].errFunc()(tptr, ARLIM(tlo), ARLIM(thi), &tagval,
-                                  &clearval, dat, ARLIM(dlo), ARLIM(dhi),
-                                  lo,hi, &ncomp, domain_lo, domain_hi,
-                                  dx, xlo, prob_lo, &time, &level);
+
+            tags[mfi].get_itags(itags, vbx);
+
+            int* tptr = itags.dataPtr();
+
+            for (int j = 0; j < nerr; j++)
+            {
+                const bool  is_state = state_comp[j] >= 0;
+                FArrayBox&  fab      = is_state ? S_err[mfi] : (*derived[j])[mfi];
+                Real*       dat      = fab.dataPtr(is_state ? state_comp[j]-scomp_lo : 0);
+                const int*  dlo      = fab.box().loVect();
+                const int*  dhi      = fab.box().hiVect();
+                const int   ncomp    = is_state ? 1 : fab.nComp();
+
+                err_list[j].errFunc()(tptr, ARLIM(lo), ARLIM(hi), &tagval,
+                                      &clearval, dat, ARLIM(dlo), ARLIM(dhi),
+                                      lo,hi, &ncomp, domain_lo, domain_hi,
+                                      dx, xlo, prob_lo, &time, &level);
+            }
             //
             // Don't forget to set the tags in the TagBox.
             //
-            tags[mfi].tags(itags);
+            tags[mfi].tags(itags, vbx);
         }
     }
 }
@@ -1664,7 +2033,6 @@ NavierStokesBase::init (AmrLevel &old)
     const Real    cur_time  = oldns->state[State_Type].curTime();
     const Real    prev_time = oldns->state[State_Type].prevTime();
     const Real    dt_old    = cur_time - prev_time;
-    MultiFab&     S_new     = get_new_data(State_Type);
     MultiFab&     P_new     = get_new_data(Press_Type);
     MultiFab&     P_old     = get_old_data(Press_Type);
 
@@ -1672,52 +2040,120 @@ NavierStokesBase::init (AmrLevel &old)
 
     const Real cur_pres_time = state[Press_Type].curTime();
     //
-    // Get best state and pressure data.
+    // Get best state, divu, dSdt and statistics data.
+    //
+    Vector<int> cell_types(1,State_Type);
+    if (have_divu)
+    {
+        cell_types.push_back(Divu_Type);
+        if (have_dsdt)
+            cell_types.push_back(Dsdt_Type);
+    }
+    if (do_running_statistics)
+        cell_types.push_back(Stats_Type);
+    if (do_work_estimates)
+        cell_types.push_back(Work_Type);
+
+    fill_from_old(*oldns,cell_types,cur_time);
     //
-    FillPatch(old,S_new,0,cur_time,State_Type,0,NUM_STATE);
+    // Get best pressure data.
     //
     // Note: we don't need to worry here about using FillPatch because
     //       it will automatically use the "old dpdt" to interpolate,
     //       since we haven't yet defined a new pressure at the lower level.
     //
+    Vector<int> node_types(1,Press_Type);
+    if (state[Press_Type].descriptor()->timeType() == StateDescriptor::Point) 
+        node_types.push_back(Dpdt_Type);
+
+    fill_from_old(*oldns,node_types,cur_pres_time);
+
+    MultiFab::Copy(P_old,P_new,0,0,1,0);
+
+    old_intersect_new          = amrex::intersect(grids,oldns->boxArray());
+    is_first_step_after_regrid = true;
+}
+
+void
+NavierStokesBase::fill_from_old (NavierStokesBase&  old,
+                                 const Vector<int>& types,
+                                 Real               time)
+{
+    BL_PROFILE("NavierStokesBase::fill_from_old()");
+    //
+    // Where the new grids are covered by the old ones FillPatch would only
+    // copy the new data of old, provided that is at time.  The data of each
+    // such type is moved by a ParallelCopy, which copies locally wherever a
+    // grid kept its box and rank; FillPatch, with interpolation from the
+    // coarser level, is then only run on the grids that are not covered.
+    //
+    Vector<int> copy_types;
+
+    for (int i = 0; i < types.size(); i++)
     {
-	FillPatchIterator fpi(old,P_new,0,cur_pres_time,Press_Type,0,1);
-	const MultiFab& mf_fpi = fpi.get_mf();
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-	for (MFIter mfi(mf_fpi,true); mfi.isValid(); ++mfi)
-	{
-	  const Box& vbx  = mfi.tilebox();
-	  const FArrayBox& pfab = mf_fpi[mfi];
+        const int  t    = types[i];
+        const Real teps = 1.e-10 * std::max(Real(1),std::abs(time));
 
-	  P_old[mfi].copy(pfab,vbx,0,vbx,0,1);
-	  P_new[mfi].copy(pfab,vbx,0,vbx,0,1);
-	}
+        if (std::abs(old.state[t].curTime() - time) <= teps)
+        {
+            copy_types.push_back(t);
+        }
+        else
+        {
+            MultiFab& mf = get_new_data(t);
+            FillPatch(old,mf,0,time,t,0,mf.nComp());
+        }
     }
 
-    if (state[Press_Type].descriptor()->timeType() == StateDescriptor::Point) 
+    if (copy_types.empty())
+        return;
+
+    const MultiFab& old0   = old.get_new_data(copy_types[0]);
+    const MultiFab& new0   = get_new_data(copy_types[0]);
+    const BoxArray& old_ba = old0.boxArray();
+    const BoxArray& new_ba = new0.boxArray();
+
+    for (int i = 0; i < copy_types.size(); i++)
     {
-        MultiFab& Dpdt_new = get_new_data(Dpdt_Type);
-	FillPatch(old,Dpdt_new,0,cur_pres_time,Dpdt_Type,0,1);
+        const int t = copy_types[i];
+
+        get_new_data(t).ParallelCopy(old.get_new_data(t),0,0,desc_lst[t].nComp());
     }
     //
-    // Get best divu and dSdt data.
+    // The grids needing data from the coarser level.
     //
-    if (have_divu)
-    {
-        MultiFab& Divu_new = get_new_data(Divu_Type);
-	FillPatch(old,Divu_new,0,cur_time,Divu_Type,0,1);
+    BoxList     bl(new_ba.ixType());
+    Vector<int> uncovered, pmap;
 
-        if (have_dsdt)
+    for (int i = 0; i < new_ba.size(); i++)
+    {
+        if (!old_ba.contains(new_ba[i]))
         {
-            MultiFab& Dsdt_new = get_new_data(Dsdt_Type);
-	    FillPatch(old,Dsdt_new,0,cur_time,Dsdt_Type,0,1);
+            bl.push_back(new_ba[i]);
+            uncovered.push_back(i);
+            pmap.push_back(new0.DistributionMap()[i]);
         }
     }
 
-    old_intersect_new          = amrex::intersect(grids,oldns->boxArray());
-    is_first_step_after_regrid = true;
+    if (uncovered.empty())
+        return;
+
+    const BoxArray            uba(bl);
+    const DistributionMapping udm(pmap);
+
+    for (int i = 0; i < copy_types.size(); i++)
+    {
+        const int t = copy_types[i];
+        const int n = desc_lst[t].nComp();
+
+        MultiFab tmp(uba,udm,n,0);
+        FillPatch(old,tmp,0,time,t,0,n);
+
+        MultiFab& mf = get_new_data(t);
+
+        for (MFIter mfi(tmp); mfi.isValid(); ++mfi)
+            mf[uncovered[mfi.index()]].copy(tmp[mfi]);
+    }
 }
 
 void
@@ -1771,6 +2207,16 @@ NavierStokesBase::init ()
         if (have_dsdt)
             FillCoarsePatch(get_new_data(Dsdt_Type),0,cur_time,Dsdt_Type,0,1);
     }
+
+    if (do_running_statistics)
+    {
+        MultiFab& Stats_new = get_new_data(Stats_Type);
+        FillCoarsePatch(Stats_new,0,cur_time,Stats_Type,0,Stats_new.nComp());
+    }
+
+    if (do_work_estimates)
+        FillCoarsePatch(get_new_data(Work_Type),0,cur_time,Work_Type,0,1);
+
     old_intersect_new = grids;
 }
 
@@ -1890,18 +2336,7 @@ NavierStokesBase::injectDown (const Box&       ovlp,
 {
     BL_PROFILE("NavierStokesBase::injectDown()");
 
-    const int*  ovlo  = ovlp.loVect();
-    const int*  ovhi  = ovlp.hiVect();
-    Real*       cpres = Pcrse.dataPtr();
-    const int*  clo   = Pcrse.loVect();
-    const int*  chi   = Pcrse.hiVect();
-    const Real* fpres = Pfine.dataPtr();
-    const int*  flo   = Pfine.loVect();
-    const int*  fhi   = Pfine.hiVect();
-
-    fort_putdown(cpres,ARLIM(clo),ARLIM(chi),
-                 fpres,ARLIM(flo),ARLIM(fhi),
-                 ovlo,ovhi,fratio.getVect());
+    NSInterp::putdown(ovlp,Pfine,Pcrse,fratio);
 }
 
 void
@@ -1911,6 +2346,7 @@ NavierStokesBase::level_projector (Real dt,
 {
     BL_PROFILE_REGION_START("R::NavierStokesBase::level_projector()");
     BL_PROFILE("NavierStokesBase::level_projector()");
+    NS_STEP_PHASE("level_projector");
 
     BL_ASSERT(iteration > 0);
 
@@ -1946,6 +2382,7 @@ NavierStokesBase::level_sync (int crse_iteration)
 {
     BL_PROFILE_REGION_START("R::NavierStokesBase::level_sync()");
     BL_PROFILE("NavierStokesBase::level_sync()");
+    NS_STEP_PHASE("level_sync");
 
     const Real*     dx            = geom.CellSize();
     IntVect         ratio         = parent->refRatio(level);
@@ -1965,6 +2402,16 @@ NavierStokesBase::level_sync (int crse_iteration)
     if (level > 0)
         crsr_sync_ptr = &(getLevel(level).getSyncReg());
     //
+    // Vsync is final here.  If periodic, start enforcing periodicity on it
+    // for the multilevel projection now and finish where it is needed, so
+    // the exchange runs while the BCs, the divu sync RHS and rho_half are
+    // set up.
+    //
+    const bool fill_vsync = do_MLsync_proj && geom.isAnyPeriodic();
+
+    if (fill_vsync)
+        Vsync.FillBoundary_nowait(0, BL_SPACEDIM, geom.periodicity());
+    //
     // Get boundary conditions.
     //
     const int N = grids.size();
@@ -2054,20 +2501,20 @@ NavierStokesBase::level_sync (int crse_iteration)
         
         MultiFab&         v_fine    = fine_level.get_new_data(State_Type);
         MultiFab&       rho_fine    = fine_level.rho_avg;
-        const Geometry& crse_geom   = parent->Geom(level);
         const BoxArray& P_finegrids = pres_fine.boxArray();
         const DistributionMapping& P_finedmap = pres_fine.DistributionMap();
 
         MultiFab phi(P_finegrids,P_finedmap,1,1);
         MultiFab V_corr(finegrids,finedmap,BL_SPACEDIM,1);
+        MemoryAccount::Tag work_tag(mem_account, level+1, MemoryAccount::SolverWork,
+                                    MemoryAccount::bytes(phi) + MemoryAccount::bytes(V_corr));
 
         V_corr.setVal(0);
         //
-        // If periodic, enforce periodicity on Vsync.
+        // If periodic, finish enforcing periodicity on Vsync.
         //
-	if (crse_geom.isAnyPeriodic()) {
-	    Vsync.FillBoundary(0, BL_SPACEDIM, crse_geom.periodicity());
-	}
+        if (fill_vsync)
+            Vsync.FillBoundary_finish();
         //
         // Interpolate Vsync to fine grid correction in Vcorr.
         //
@@ -2208,6 +2655,7 @@ NavierStokesBase::mac_project (Real      time,
 {
     BL_PROFILE_REGION_START("R::NavierStokesBase::mac_project()");
     BL_PROFILE("NavierStokesBase::mac_project()");
+    NS_STEP_PHASE("mac_project");
 
     if (verbose) amrex::Print() << "... mac_projection\n";
 
@@ -2548,19 +2996,93 @@ void
 NavierStokesBase::post_regrid (int lbase,
 			       int new_finest)
 {
+    if (do_work_estimates && level == lbase && lbase < new_finest)
+        remapByWork(lbase, new_finest);
+
 #ifdef AMREX_PARTICLES
     if (NSPC && level == lbase)
     {
         NSPC->Redistribute(lbase);
+
+        particle_sorter.invalidateAll();
+        if (particle_sort_int > 0)
+            for (int lev = 0; lev <= new_finest; lev++)
+                particle_sorter.sort(*NSPC, lev);
     }
 #endif
+
+    account_memory();
+
+    if (level == new_finest)
+    {
+        mem_account.truncate(new_finest);
+        mem_account.reduce();
+
+        if (memory_report)
+        {
+            std::ostringstream os;
+            mem_account.print(os);
+            amrex::Print() << "NavierStokesBase::post_regrid(): memory use\n" << os.str();
+        }
+    }
 }
 
-//
-// Build any additional data structures after restart.
-//
 void
-NavierStokesBase::post_restart ()
+NavierStokesBase::account_memory ()
+{
+    long nstate = 0;
+    for (int k = 0; k < num_state_type; k++)
+    {
+        nstate += MemoryAccount::bytes(state[k].newData());
+        if (state[k].hasOldData())
+            nstate += MemoryAccount::bytes(state[k].oldData());
+    }
+
+    long ngeom = MemoryAccount::bytes(volume);
+    long nmac  = 0;
+    for (int d = 0; d < BL_SPACEDIM; d++)
+    {
+        ngeom += MemoryAccount::bytes(area[d]);
+        if (u_mac != 0)
+            nmac += MemoryAccount::bytes(u_mac[d]);
+    }
+
+    long nrho = MemoryAccount::bytes(rho_avg)   + MemoryAccount::bytes(rho_half)
+              + MemoryAccount::bytes(rho_ptime) + MemoryAccount::bytes(rho_ctime);
+    if (rho_qtime  != 0) nrho += MemoryAccount::bytes(*rho_qtime);
+    if (rho_tqtime != 0) nrho += MemoryAccount::bytes(*rho_tqtime);
+
+    long ntrans = 0;
+    if (viscn_cc   != 0) ntrans += MemoryAccount::bytes(*viscn_cc);
+    if (viscnp1_cc != 0) ntrans += MemoryAccount::bytes(*viscnp1_cc);
+    if (diffn_cc   != 0) ntrans += MemoryAccount::bytes(*diffn_cc);
+    if (diffnp1_cc != 0) ntrans += MemoryAccount::bytes(*diffnp1_cc);
+
+    long nreg = 0;
+    if (advflux_reg  != 0) nreg += MemoryAccount::bytes(*advflux_reg);
+    if (viscflux_reg != 0) nreg += MemoryAccount::bytes(*viscflux_reg);
+    for (int reg = 0; reg < NumCrseFluxRegs; reg++)
+        for (int dir = 0; dir < BL_SPACEDIM; dir++)
+            nreg += MemoryAccount::bytes(crse_flux_stage[reg][dir].flux);
+    if (sync_reg     != 0) nreg += sync_reg->nBytes();
+
+    mem_account.set(level, MemoryAccount::State,     nstate);
+    mem_account.set(level, MemoryAccount::Geometry,  ngeom);
+    mem_account.set(level, MemoryAccount::MacVel,    nmac);
+    mem_account.set(level, MemoryAccount::Advection, (aofs != 0) ? MemoryAccount::bytes(*aofs) : 0);
+    mem_account.set(level, MemoryAccount::Density,   nrho);
+    mem_account.set(level, MemoryAccount::Sync,      MemoryAccount::bytes(Vsync) +
+                                                     MemoryAccount::bytes(Ssync) +
+                                                     MemoryAccount::bytes(p_avg));
+    mem_account.set(level, MemoryAccount::Transport, ntrans);
+    mem_account.set(level, MemoryAccount::Registers, nreg);
+}
+
+//
+// Build any additional data structures after restart.
+//
+void
+NavierStokesBase::post_restart ()
 {
     make_rho_prev_time();
     make_rho_curr_time();
@@ -2568,6 +3090,12 @@ NavierStokesBase::post_restart ()
 #ifdef AMREX_PARTICLES
     post_restart_particle ();
 #endif
+
+    if (level == 0)
+    {
+        step_timer.clear();
+        SolverStats::clear();
+    }
 }
 
 //
@@ -2614,6 +3142,13 @@ NavierStokesBase::post_timestep (int crse_iteration)
     {
         sum_integrated_quantities();
     }
+    //
+    // Accumulate running statistics.
+    //
+    if (do_running_statistics && (parent->levelSteps(level)%running_statistics_interval == 0))
+    {
+        add_running_statistics(running_statistics_interval*parent->dtLevel(level));
+    }
 #if (BL_SPACEDIM==3)
     //
     // Derive turbulent statistics
@@ -2638,38 +3173,41 @@ NavierStokesBase::post_timestep (int crse_iteration)
     old_intersect_new          = grids;
     is_first_step_after_regrid = false;
 
-    if (level == 0 && dump_plane >= 0)
+    if (level == 0 && !dump_plane_dir.empty())
     {
-        Box bx = geom.Domain();
-
-        BL_ASSERT(bx.bigEnd(BL_SPACEDIM-1) >= dump_plane);
-
-        bx.setSmall(BL_SPACEDIM-1, dump_plane);
-        bx.setBig  (BL_SPACEDIM-1, dump_plane);
-
-        BoxArray ba(bx);
-        DistributionMapping dm{ba};
-
-        MultiFab mf(ba, dm, BL_SPACEDIM, 0);
-
-        mf.copy(get_new_data(State_Type), Xvel, 0, BL_SPACEDIM);
-
-        if (ParallelDescriptor::MyProc() == mf.DistributionMap()[0])
+        if (plane_writers.empty())
         {
-            char buf[64];
-            sprintf(buf, "%14.12e", state[State_Type].curTime());
-
-            std::string name(dump_plane_name);
-            name += buf;
-            name += ".fab";
+            for (int i = 0; i < dump_plane_dir.size(); i++)
+            {
+                plane_writers.push_back(new PlaneWriter(geom.Domain(),
+                                                        dump_plane_dir[i],
+                                                        dump_plane_loc[i],
+                                                        dump_plane_comps,
+                                                        dump_plane_buffer,
+                                                        dump_plane_chunk,
+                                                        dump_plane_name));
+            }
+        }
 
-            std::ofstream ofs;
-            ofs.open(name.c_str(),std::ios::out|std::ios::trunc|std::ios::binary);
-            if (!ofs.good())
-                amrex::FileOpenFailed(name);
+        for (int i = 0; i < plane_writers.size(); i++)
+        {
+            plane_writers[i]->add(get_new_data(State_Type),
+                                  state[State_Type].curTime(),
+                                  parent->levelSteps(0));
+        }
+    }
 
-            mf[0].writeOn(ofs);
+    if (level == 0)
+    {
+        if (step_timing)
+        {
+            step_timer.report(step_timing_file,
+                              parent->levelSteps(0),
+                              state[State_Type].curTime(),
+                              parent->dtLevel(0),
+                              SolverStats::json());
         }
+        SolverStats::clear();
     }
 }
 
@@ -2714,6 +3252,12 @@ NavierStokesBase::resetState (Real time,
             state[Dsdt_Type].setTimeLevel(time,dt_old,dt_new);
         }
     }
+
+    if (do_running_statistics)
+        state[Stats_Type].setTimeLevel(time,dt_old,dt_new);
+
+    if (do_work_estimates)
+        state[Work_Type].setTimeLevel(time,dt_old,dt_new);
 }
 
 void
@@ -2722,6 +3266,22 @@ NavierStokesBase::restart (Amr&          papa,
                        bool          bReadSpecial)
 {
     AmrLevel::restart(papa,is,bReadSpecial);
+    //
+    // If this is an incremental checkpoint, AmrLevel::restart() read
+    // the base; apply the changed FABs on top of it.
+    //
+    DeltaCheckpoint::replay(*this, papa.theRestartFile());
+    //
+    // Pick up the running turbulence statistics and drop the records
+    // written after the checkpoint.
+    //
+    if (level == 0 && turb_stats && ParallelDescriptor::IOProcessor())
+    {
+        delete turb_acc;
+        turb_acc = TurbStatsAccumulator::restart(papa.theRestartFile());
+        if (turb_acc != 0)
+            turb_acc->truncate(turb_stats_file);
+    }
 
     //
     // Build metric coefficients for RZ calculations.
@@ -2886,63 +3446,48 @@ NavierStokesBase::scalar_advection_update (Real dt,
     if (sComp <= last_scalar)
     {
         const MultiFab& rho_halftime = get_rho_half_time();
+        //
+        // The scalars after density act on one another only through the
+        // half-time scalars handed to getForce().  Updated one after the
+        // other each sees those updated before it.  With scalar_update_tasks
+        // the updates of a tile are OpenMP tasks instead, which all see the
+        // half-time scalars from before the first of them, so that threads
+        // done with their own tiles take on the scalars of the others.  An
+        // order given with do_scalar_update_in_order is always kept.
+        //
+        const bool as_tasks = scalar_update_tasks && !do_scalar_update_in_order
+                              && sComp < last_scalar;
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
 {
-        FArrayBox  tforces;
+        FArrayBox Scal;
 
         for (MFIter Rho_mfi(rho_halftime,true); Rho_mfi.isValid(); ++Rho_mfi)
         {
-            const Box& bx = Rho_mfi.tilebox();
+            const Box bx  = Rho_mfi.tilebox();
+            const int idx = Rho_mfi.index();
 
             for (int sigma = sComp; sigma <= last_scalar; sigma++)
             {
-		// Need to do some funky half-time stuff
-		if (getForceVerbose)
-  		    amrex::Print() << "---" << '\n' << "E - scalar advection update (half time):" << '\n';
-
-		// Average the mac face velocities to get cell centred velocities
-                const Real halftime = 0.5*(state[State_Type].curTime()+state[State_Type].prevTime());
-		FArrayBox Vel(amrex::grow(bx,0),BL_SPACEDIM);
-		const int* vel_lo  = Vel.loVect();
-		const int* vel_hi  = Vel.hiVect();
-		const int* umacx_lo = u_mac[0][Rho_mfi].loVect();
-		const int* umacx_hi = u_mac[0][Rho_mfi].hiVect();
-		const int* umacy_lo = u_mac[1][Rho_mfi].loVect();
-		const int* umacy_hi = u_mac[1][Rho_mfi].hiVect();
-#if (BL_SPACEDIM==3)
-		const int* umacz_lo = u_mac[2][Rho_mfi].loVect();
-		const int* umacz_hi = u_mac[2][Rho_mfi].hiVect();
-#endif
-		FORT_AVERAGE_EDGE_STATES(Vel.dataPtr(),
-					 u_mac[0][Rho_mfi].dataPtr(),
-					 u_mac[1][Rho_mfi].dataPtr(),
-#if (BL_SPACEDIM==3)
-					 u_mac[2][Rho_mfi].dataPtr(),
-#endif
-					 ARLIM(vel_lo),  ARLIM(vel_hi),
-					 ARLIM(umacx_lo), ARLIM(umacx_hi),
-					 ARLIM(umacy_lo), ARLIM(umacy_hi),
-#if (BL_SPACEDIM==3)
-					 
-					 ARLIM(umacz_lo), ARLIM(umacz_hi),
+                if (!as_tasks || sigma == sComp)
+                {
+                    //
+                    // Average the new and old time to get Crank-Nicholson half time approximation.
+                    //
+                    Scal.resize(amrex::grow(bx,0),NUM_SCALARS);
+                    Scal.copy(S_old[Rho_mfi],bx,Density,bx,0,NUM_SCALARS);
+                    Scal.plus(S_new[Rho_mfi],bx,Density,0,NUM_SCALARS);
+                    Scal.mult(0.5,bx);
+                }
+#ifdef _OPENMP
+#pragma omp task if(as_tasks) shared(Scal)
 #endif
-					 &getForceVerbose);
-		//
-		// Average the new and old time to get Crank-Nicholson half time approximation.
-		//
-		FArrayBox Scal(amrex::grow(bx,0),NUM_SCALARS);
-		Scal.copy(S_old[Rho_mfi],bx,Density,bx,0,NUM_SCALARS);
-		Scal.plus(S_new[Rho_mfi],bx,Density,0,NUM_SCALARS);
-		Scal.mult(0.5,bx);
-		
-		if (getForceVerbose) amrex::Print() << "Calling getForce..." << '\n';
-                getForce(tforces,bx,0,sigma,1,halftime,Vel,Scal,0);
-
-                godunov->Add_aofs_tf(S_old[Rho_mfi],S_new[Rho_mfi],sigma,1,
-                                     Aofs[Rho_mfi],sigma,tforces,0,bx,dt);
+                scalar_advection_update_tile(dt,sigma,idx,bx,Scal);
             }
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
         }
 }
     }
@@ -2995,9 +3540,65 @@ NavierStokesBase::scalar_advection_update (Real dt,
     }
 }
 
+//
+// The explicit update of scalar sigma on the tile bx of box idx, forced
+// with the half-time scalars Scal.
+//
+void
+NavierStokesBase::scalar_advection_update_tile (Real             dt,
+                                                int              sigma,
+                                                int              idx,
+                                                const Box&       bx,
+                                                const FArrayBox& Scal)
+{
+    MultiFab&  S_old     = get_old_data(State_Type);
+    MultiFab&  S_new     = get_new_data(State_Type);
+    MultiFab&  Aofs      = *aofs;
+
+    // Need to do some funky half-time stuff
+    if (getForceVerbose)
+        amrex::Print() << "---" << '\n' << "E - scalar advection update (half time):" << '\n';
+
+    // Average the mac face velocities to get cell centred velocities
+    const Real halftime = 0.5*(state[State_Type].curTime()+state[State_Type].prevTime());
+    FArrayBox Vel(amrex::grow(bx,0),BL_SPACEDIM);
+    const int* vel_lo  = Vel.loVect();
+    const int* vel_hi  = Vel.hiVect();
+    const int* umacx_lo = u_mac[0][idx].loVect();
+    const int* umacx_hi = u_mac[0][idx].hiVect();
+    const int* umacy_lo = u_mac[1][idx].loVect();
+    const int* umacy_hi = u_mac[1][idx].hiVect();
+#if (BL_SPACEDIM==3)
+    const int* umacz_lo = u_mac[2][idx].loVect();
+    const int* umacz_hi = u_mac[2][idx].hiVect();
+#endif
+    FORT_AVERAGE_EDGE_STATES(Vel.dataPtr(),
+                             u_mac[0][idx].dataPtr(),
+                             u_mac[1][idx].dataPtr(),
+#if (BL_SPACEDIM==3)
+                             u_mac[2][idx].dataPtr(),
+#endif
+                             ARLIM(vel_lo),  ARLIM(vel_hi),
+                             ARLIM(umacx_lo), ARLIM(umacx_hi),
+                             ARLIM(umacy_lo), ARLIM(umacy_hi),
+#if (BL_SPACEDIM==3)
+                             ARLIM(umacz_lo), ARLIM(umacz_hi),
+#endif
+                             &getForceVerbose);
+
+    FArrayBox tforces;
+
+    if (getForceVerbose) amrex::Print() << "Calling getForce..." << '\n';
+    getForce(tforces,bx,0,sigma,1,halftime,Vel,Scal,0);
+
+    godunov->Add_aofs_tf(S_old[idx],S_new[idx],sigma,1,
+                         Aofs[idx],sigma,tforces,0,bx,dt);
+}
+
 //
 // Set the time levels to time (time) and timestep dt.
 //
+
 void
 NavierStokesBase::setTimeLevel (Real time,
 				Real dt_old,
@@ -3014,6 +3615,12 @@ NavierStokesBase::setTimeLevel (Real time,
         }
     }
 
+    if (do_running_statistics)
+        state[Stats_Type].setTimeLevel(time,dt_old,dt_new);
+
+    if (do_work_estimates)
+        state[Work_Type].setTimeLevel(time,dt_old,dt_new);
+
     if (state[Press_Type].descriptor()->timeType() == StateDescriptor::Interval) 
     {
         state[Press_Type].setTimeLevel(time-dt_old,dt_old,dt_old);
@@ -3048,6 +3655,80 @@ NavierStokesBase::sync_cleanup (MultiFab*& DeltaSsync)
     DeltaSsync = 0;
 }
 
+namespace
+{
+    //
+    // A MultiFab of at least ncomp components, without ghost cells, on the
+    // coarse boxes interp needs to fill the boxes of fba on f_lev from
+    // c_lev, distributed like fba with fdm.  Its contents are whatever the
+    // last caller left.
+    //
+    MultiFab&
+    syncCrseData (int                        c_lev,
+                  int                        f_lev,
+                  Interpolater*              interp,
+                  const BoxArray&            fba,
+                  const DistributionMapping& fdm,
+                  const IntVect&             ratio,
+                  int                        ncomp)
+    {
+        SyncCrseData& c = sync_crse_data[std::make_pair(std::make_pair(c_lev,f_lev),interp)];
+
+        if (!(c.fba == fba) || c.cba.size() != fba.size())
+        {
+            const int N = fba.size();
+
+            BoxArray cba(N);
+
+            for (int i = 0; i < N; i++)
+                cba.set(i,interp->CoarseBox(fba[i],ratio));
+
+            c.fba = fba;
+            c.cba = cba;
+            c.cmf.reset();
+        }
+
+        if (!c.cmf || !(c.cmf->DistributionMap() == fdm) || c.cmf->nComp() < ncomp)
+            c.cmf.reset(new MultiFab(c.cba,fdm,ncomp,0));
+
+        return *c.cmf;
+    }
+    //
+    // For every direction, low sides then high sides, the last coarse grid
+    // touching that side of cdomain, or -1; the physical BC of a coarse
+    // quantity outside the domain is taken from that grid.
+    //
+    const int*
+    syncBCGrids (int             c_lev,
+                 const BoxArray& cgrids,
+                 const Box&      cdomain)
+    {
+        SyncBCGrids& c = sync_bc_grids[c_lev];
+
+        if (!(c.cgrids == cgrids) || c.cdomain != cdomain)
+        {
+            for (int dir = 0; dir < BL_SPACEDIM; dir++)
+            {
+                c.grid[dir]             = -1;
+                c.grid[dir+BL_SPACEDIM] = -1;
+
+                for (int crse = 0, N = cgrids.size(); crse < N; crse++)
+                {
+                    if (cgrids[crse].smallEnd(dir) == cdomain.smallEnd(dir))
+                        c.grid[dir] = crse;
+                    if (cgrids[crse].bigEnd(dir) == cdomain.bigEnd(dir))
+                        c.grid[dir+BL_SPACEDIM] = crse;
+                }
+            }
+
+            c.cgrids  = cgrids;
+            c.cdomain = cdomain;
+        }
+
+        return c.grid;
+    }
+}
+
 //
 // Helper function for NavierStokesBase::SyncInterp().
 //
@@ -3060,7 +3741,7 @@ set_bc_new (int*            bc_new,
             const int*      chi,
             const int*      cdomlo,
             const int*      cdomhi,
-            const BoxArray& cgrids,
+            const int*      bc_grid,
             int**           bc_orig_qty)
             
 {
@@ -3070,20 +3751,10 @@ set_bc_new (int*            bc_new,
         bc_new[bc_index]             = INT_DIR;
         bc_new[bc_index+BL_SPACEDIM] = INT_DIR;
  
-        if (clo[dir] < cdomlo[dir] || chi[dir] > cdomhi[dir])
-        {
-            for (int crse = 0, N = cgrids.size(); crse < N; crse++)
-            {
-		const Box& bx = cgrids[crse];
-                const int* c_lo = bx.loVect();
-                const int* c_hi = bx.hiVect();
-
-                if (clo[dir] < cdomlo[dir] && c_lo[dir] == cdomlo[dir])
-                    bc_new[bc_index] = bc_orig_qty[crse][bc_index];
-                if (chi[dir] > cdomhi[dir] && c_hi[dir] == cdomhi[dir])
-                    bc_new[bc_index+BL_SPACEDIM] = bc_orig_qty[crse][bc_index+BL_SPACEDIM]; 
-            }
-        }
+        if (clo[dir] < cdomlo[dir] && bc_grid[dir] >= 0)
+            bc_new[bc_index] = bc_orig_qty[bc_grid[dir]][bc_index];
+        if (chi[dir] > cdomhi[dir] && bc_grid[dir+BL_SPACEDIM] >= 0)
+            bc_new[bc_index+BL_SPACEDIM] = bc_orig_qty[bc_grid[dir+BL_SPACEDIM]][bc_index+BL_SPACEDIM]; 
     }
 }
 
@@ -3137,19 +3808,15 @@ NavierStokesBase::SyncInterp (MultiFab&      CrseSync,
     Box             cdomain    = amrex::coarsen(fgeom.Domain(),ratio);
     const int*      cdomlo     = cdomain.loVect();
     const int*      cdomhi     = cdomain.hiVect();
-    const int       N          = fgrids.size();
-
-    BoxArray cdataBA(N);
-
-    for (int i = 0; i < N; i++)
-        cdataBA.set(i,interpolater->CoarseBox(fgrids[i],ratio));
+    const int*      bc_grid    = syncBCGrids(c_lev,cgrids,cdomain);
     //
-    // Note: The boxes in cdataBA may NOT be disjoint !!!
+    // Note: The boxes of cdataMF may NOT be disjoint !!!
+    // Only its first num_comp components are used.
     //
-    MultiFab cdataMF(cdataBA,fdmap,num_comp,0);
+    MultiFab& cdataMF = syncCrseData(c_lev,f_lev,interpolater,fgrids,fdmap,ratio,num_comp);
 
     // Coarse box could expand beyond the extent of fine box depending on the interpolation type, so initialize here
-    cdataMF.setVal(0);
+    cdataMF.setVal(0,0,num_comp);
 
     cdataMF.copy(CrseSync, src_comp, 0, num_comp);
     //
@@ -3177,7 +3844,7 @@ NavierStokesBase::SyncInterp (MultiFab&      CrseSync,
 
         for (int n = 0; n < num_comp; n++)
         {
-          set_bc_new(bc_new,n,src_comp,lo,hi,cdomlo,cdomhi,cgrids,bc_orig_qty);
+          set_bc_new(bc_new,n,src_comp,lo,hi,cdomlo,cdomhi,bc_grid,bc_orig_qty);
 	    
 	  filcc_tile(ARLIM(lo),ARLIM(hi),
 		     cdata.dataPtr(n), ARLIM(clo), ARLIM(chi),
@@ -3188,7 +3855,7 @@ NavierStokesBase::SyncInterp (MultiFab&      CrseSync,
       delete [] bc_new;
     }
     
-    cdataMF.EnforcePeriodicity(cgeom.periodicity());
+    cdataMF.EnforcePeriodicity(0,num_comp,cgeom.periodicity());
     //
     // Interpolate from cdataMF to fdata and update FineSync.
     // Note that FineSync and cdataMF will have the same distribution
@@ -3225,7 +3892,7 @@ NavierStokesBase::SyncInterp (MultiFab&      CrseSync,
 	  //
 	  for (int n = 0; n < num_comp; n++)
 	  {
-	      set_bc_new(bc_new,n,src_comp,clo,chi,cdomlo,cdomhi,cgrids,bc_orig_qty);
+	      set_bc_new(bc_new,n,src_comp,clo,chi,cdomlo,cdomhi,bc_grid,bc_orig_qty);
 	  }
 
 	  for (int n = 0; n < num_comp; n++)
@@ -3244,23 +3911,27 @@ NavierStokesBase::SyncInterp (MultiFab&      CrseSync,
 			       cgeom,fgeom,bc_interp,src_comp,State_Type, RunOn::Cpu);
 	  //        reScaleFineSyncInterp(fdata, f_lev, num_comp);
 
-	  if (increment)
+	  if (increment && interpolater == &protected_interp)
 	  {
 	      fdata.mult(dt_clev);
 
-	      if (interpolater == &protected_interp)
-	      {	      
-		  cdata.mult(dt_clev,cbx);
-		  FArrayBox& fine_state = (*fine_stateMF)[mfi];
-		  interpolater->protect(cdata,0,fdata,0,fine_state,state_comp,
-					num_comp,fbx,ratio,
-					cgeom,fgeom,bc_interp, RunOn::Cpu);
-		  Real dt_clev_inv = 1./dt_clev;
-		  cdata.mult(dt_clev_inv,cbx);
-	      }
-            
+	      cdata.mult(dt_clev,cbx);
+	      FArrayBox& fine_state = (*fine_stateMF)[mfi];
+	      interpolater->protect(cdata,0,fdata,0,fine_state,state_comp,
+				    num_comp,fbx,ratio,
+				    cgeom,fgeom,bc_interp, RunOn::Cpu);
+	      Real dt_clev_inv = 1./dt_clev;
+	      cdata.mult(dt_clev_inv,cbx);
+
 	      FineSync[mfi].plus(fdata,fbx,0,dest_comp,num_comp);
 	  }
+	  else if (increment)
+	  {
+	      //
+	      // Scale and add in one pass.
+	      //
+	      FineSync[mfi].saxpy(dt_clev,fdata,fbx,fbx,0,dest_comp,num_comp);
+	  }
 	  else
 	  {
 	      FineSync[mfi].copy(fdata,fbx,0,fbx,dest_comp,num_comp);
@@ -3287,22 +3958,14 @@ NavierStokesBase::SyncProjInterp (MultiFab& phi,
     BL_PROFILE("NavierStokesBase:::SyncProjInterp()");
 
     const BoxArray& P_grids = P_new.boxArray();
-    const int       N       = P_grids.size();
-
-    BoxArray crse_ba(N);
-
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for (int i = 0; i < N; i++)
-        crse_ba.set(i,node_bilinear_interp.CoarseBox(P_grids[i],ratio));
 
     // None  of these 3 are actually used by node_bilinear_interp()
     Vector<BCRec> bc(BL_SPACEDIM);
     const Geometry& fgeom   = parent->Geom(f_lev);
     const Geometry& cgeom   = parent->Geom(c_lev);
 
-    MultiFab     crse_phi(crse_ba,P_new.DistributionMap(),1,0);
+    MultiFab& crse_phi = syncCrseData(c_lev,f_lev,&node_bilinear_interp,P_grids,
+                                      P_new.DistributionMap(),ratio,1);
     crse_phi.setVal(1.e200);
     crse_phi.copy(phi,0,0,1);
 
@@ -3383,6 +4046,7 @@ void
 NavierStokesBase::velocity_advection (Real dt)
 {
     BL_PROFILE("NavierStokesBase::velocity_advection()");
+    NS_STEP_PHASE("velocity_advection");
 
     if (verbose)
     {
@@ -3454,10 +4118,12 @@ NavierStokesBase::velocity_advection (Real dt)
       FArrayBox tforces;
       FArrayBox S;
       FArrayBox cfluxes[BL_SPACEDIM];
+      MemoryAccount::Tag work_tag(mem_account, level, MemoryAccount::GodunovWork);
       for (MFIter U_mfi(Umf,true); U_mfi.isValid(); ++U_mfi)
       {
 
 	    const Box& bx=U_mfi.tilebox();
+	    const Real strt_time = ParallelDescriptor::second();
 		
 	    if (getForceVerbose)
 	    {
@@ -3483,6 +4149,9 @@ NavierStokesBase::velocity_advection (Real dt)
         //
         S.resize(grow(bx,Godunov::hypgrow()),BL_SPACEDIM); 
         S.copy(Umf[U_mfi],0,0,BL_SPACEDIM);
+
+        work_tag.grow(tforces.nBytes() + S.nBytes() +
+                      D_TERM(cfluxes[0].nBytes(), + cfluxes[1].nBytes(), + cfluxes[2].nBytes()));
 		
         FArrayBox& divufab = divu_fp[U_mfi];
         FArrayBox& aofsfab = (*aofs)[U_mfi];
@@ -3519,6 +4188,8 @@ NavierStokesBase::velocity_advection (Real dt)
               }
             }
         }
+
+        addWork(U_mfi, ParallelDescriptor::second() - strt_time);
       } // end of MFIter
 }
 
@@ -3534,7 +4205,7 @@ NavierStokesBase::velocity_advection (Real dt)
         if(level < finest_level)
 	{
 	  for (int i = 0; i < BL_SPACEDIM; i++)
-	    getAdvFluxReg(level+1).CrseInit(fluxes[i],i,0,0,BL_SPACEDIM,-dt);
+	    stageCrseFlux(AdvFluxReg,fluxes[i],i,0,0,BL_SPACEDIM,-dt);
 	}
     }
 }
@@ -3557,6 +4228,7 @@ void
 NavierStokesBase::velocity_update (Real dt)
 {
     BL_PROFILE("NavierStokesBase::velocity_update()");
+    NS_STEP_PHASE("velocity_update");
 
     if (verbose)
     {
@@ -3789,10 +4461,20 @@ Real
 NavierStokesBase::volWgtSum (const std::string& name,
 			     Real               time)
 {
-    Real        sum = 0.0;
-    const Real* dx  = geom.CellSize();
-    auto        mf  = derive(name,time,0);
-    BoxArray    baf;
+    Vector<std::string> sum_names(1,name), max_names;
+    Vector<Real>        sums(1,0.0), maxs;
+
+    integrals(sum_names,max_names,time,sums,maxs);
+
+    ParallelDescriptor::ReduceRealSum(sums[0]);
+
+    return sums[0];
+}
+
+const iMultiFab&
+NavierStokesBase::fineCoverMask ()
+{
+    BoxArray baf;
 
     if (level < parent->finestLevel())
     {
@@ -3800,72 +4482,434 @@ NavierStokesBase::volWgtSum (const std::string& name,
         baf.coarsen(fine_ratio);
     }
 
-    std::vector< std::pair<int,Box> > isects;
+    if (fine_mask && baf == fine_mask_ba)
+        return *fine_mask;
+
+    fine_mask.reset(new iMultiFab(grids,dmap,1,0));
+    fine_mask->setVal(1);
 
-    for (MFIter mfi(*mf); mfi.isValid(); ++mfi)
+    if (!baf.empty())
     {
-        FArrayBox& fab = (*mf)[mfi];
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector< std::pair<int,Box> > isects;
+
+            for (MFIter mfi(*fine_mask); mfi.isValid(); ++mfi)
+            {
+                baf.intersections(grids[mfi.index()],isects);
 
-        if (level < parent->finestLevel())
+                for (int ii = 0, N = isects.size(); ii < N; ii++)
+                    (*fine_mask)[mfi].setVal(0,isects[ii].second,0,1);
+            }
+        }
+    }
+
+    fine_mask_ba = baf;
+
+    return *fine_mask;
+}
+
+void
+NavierStokesBase::integrals (const Vector<std::string>& sum_names,
+                             const Vector<std::string>& max_names,
+                             Real                       time,
+                             Vector<Real>&              sums,
+                             Vector<Real>&              maxs)
+{
+    BL_PROFILE("NavierStokesBase::integrals()");
+
+    const int nsum = sum_names.size();
+    const int nmax = max_names.size();
+    const int nq   = nsum + nmax;
+
+    BL_ASSERT(sums.size() == nsum);
+    BL_ASSERT(maxs.size() == nmax);
+
+    const Real* dx = geom.CellSize();
+    const Real  dt = parent->dtLevel(level);
+    //
+    // The state variables and the quantities with a Fortran derive
+    // function on cell-centered state are evaluated here, tile by tile,
+    // from one FillPatch per state type of the union of the components
+    // they need.  The rest (the particle counts, and anything derived from
+    // the nodal pressure) still go through derive().
+    //
+    const int ntypes = desc_lst.size();
+
+    Vector<const DeriveRec*>           recs(nq,0);
+    Vector<int>                        qtype(nq,-1), qcomp(nq,-1), qgrow(nq,0);
+    Vector<std::unique_ptr<MultiFab> > derived(nq);
+    Vector<int>                        lo_comp(ntypes,-1), hi_comp(ntypes,-1), fill_grow(ntypes,0);
+
+    for (int q = 0; q < nq; q++)
+    {
+        const std::string& name = (q < nsum) ? sum_names[q] : max_names[q-nsum];
+        const DeriveRec*   rec  = derive_lst.get(name);
+
+        int  type, comp;
+        bool here = false;
+
+        if (isStateVariable(name,type,comp))
         {
-            baf.intersections(grids[mfi.index()],isects);
+            here     = desc_lst[type].getType() == IndexType::TheCellType();
+            qtype[q] = type;
+            qcomp[q] = comp;
+        }
+        else if (rec != 0 && rec->derFunc() != 0 &&
+                 name != "particle_count" && name != "total_particle_count")
+        {
+            here = true;
+            for (int k = 0, ncomp; k < rec->numRange(); k++)
+            {
+                rec->getRange(k,type,comp,ncomp);
+                here = here && desc_lst[type].getType() == IndexType::TheCellType();
+            }
+            const Box b0(IntVect::TheZeroVector(),IntVect::TheZeroVector());
+            recs[q]  = rec;
+            qgrow[q] = -rec->boxMap()(b0).smallEnd(0);
+        }
 
-            for (int ii = 0, N = isects.size(); ii < N; ii++)
-                fab.setVal(0,isects[ii].second,0,fab.nComp());
+        if (!here)
+        {
+            recs[q]    = 0;
+            qtype[q]   = -1;
+            derived[q] = derive(name,time,0);
+            continue;
         }
-        Real        s;
-        const Real* dat = fab.dataPtr();
-        const int*  dlo = fab.loVect();
-        const int*  dhi = fab.hiVect();
-        const Box&  grdbx = grids[mfi.index()];
-        const int*  lo  = grdbx.loVect();
-        const int*  hi  = grdbx.hiVect();
 
-#if (BL_SPACEDIM == 2)
-        int   rz_flag = Geom().IsRZ() ? 1 : 0;
-        Real* rad     = &radius[mfi.index()][0];
-        int   irlo    = lo[0]-radius_grow;
-        int   irhi    = hi[0]+radius_grow;
-        //
-        // Note that this routine will do a volume weighted sum of
-        // whatever quantity is passed in, not strictly the "mass".
-        //
-        if (volWgtSum_sub_dz > 0 && volWgtSum_sub_Rcyl > 0)
+        const int nrange = (recs[q] != 0) ? rec->numRange() : 1;
+
+        for (int k = 0; k < nrange; k++)
         {
-            const Real* plo = geom.ProbLo();
-            summass_cyl(dat,ARLIM(dlo),ARLIM(dhi),ARLIM(lo),ARLIM(hi),
-                             dx,&s,rad,&irlo,&irhi,&rz_flag,plo,
-                             &volWgtSum_sub_dz,&volWgtSum_sub_Rcyl);
+            int ncomp = 1;
+            if (recs[q] != 0)
+                rec->getRange(k,type,comp,ncomp);
+
+            lo_comp[type]   = (lo_comp[type] < 0) ? comp : std::min(lo_comp[type],comp);
+            hi_comp[type]   = std::max(hi_comp[type],comp+ncomp);
+            fill_grow[type] = std::max(fill_grow[type],qgrow[q]);
         }
-        else
+    }
+
+    Vector<std::unique_ptr<MultiFab> > src(ntypes);
+
+    for (int type = 0; type < ntypes; type++)
+    {
+        if (lo_comp[type] < 0)
+            continue;
+
+        const int ncomp = hi_comp[type] - lo_comp[type];
+
+        src[type].reset(new MultiFab(state[type].boxArray(),dmap,ncomp,fill_grow[type]));
+        FillPatch(*this,*src[type],fill_grow[type],time,type,lo_comp[type],ncomp,0);
+    }
+
+    const iMultiFab& mask = fineCoverMask();
+
+    Vector<Real> lev_sums(nsum,0), lev_maxs(maxs);
+
+#ifdef _OPENMP
+#pragma omp parallel if (!system::regtest_reduction)
+#endif
+    {
+        Vector<Real> tsums(nsum,0), tmaxs(maxs);
+        FArrayBox    srcfab, dfab;
+
+        for (MFIter mfi(mask,true); mfi.isValid(); ++mfi)
+        {
+            const Box& bx      = mfi.tilebox();
+            const int* lo      = bx.loVect();
+            const int* hi      = bx.hiVect();
+            const int  grid_no = mfi.index();
+            auto       m       = mask.array(mfi);
+
+            for (int q = 0; q < nq; q++)
+            {
+                FArrayBox* fabp = &dfab;
+
+                if (derived[q])
+                {
+                    fabp = &(*derived[q])[mfi];
+                }
+                else if (recs[q] == 0)
+                {
+                    //
+                    // A state variable.
+                    //
+                    const int type = qtype[q];
+                    dfab.resize(bx,1);
+                    dfab.copy((*src[type])[mfi],bx,qcomp[q]-lo_comp[type],bx,0,1);
+                }
+                else
+                {
+                    const DeriveRec* rec = recs[q];
+                    int              type, comp, ncomp;
+                    //
+                    // The derive functions want their ranges contiguous and
+                    // in order; a single range is read in place.
+                    //
+                    FArrayBox* cfab  = &srcfab;
+                    int        ccomp = 0;
+
+                    if (rec->numRange() == 1)
+                    {
+                        rec->getRange(0,type,comp,ncomp);
+                        cfab  = &(*src[type])[mfi];
+                        ccomp = comp - lo_comp[type];
+                    }
+                    else
+                    {
+                        const Box gbx = amrex::grow(bx,qgrow[q]);
+                        srcfab.resize(gbx,rec->numState());
+                        for (int k = 0, dc = 0; k < rec->numRange(); k++, dc += ncomp)
+                        {
+                            rec->getRange(k,type,comp,ncomp);
+                            srcfab.copy((*src[type])[mfi],gbx,comp-lo_comp[type],gbx,dc,ncomp);
+                        }
+                    }
+
+                    dfab.resize(bx,rec->numDerive());
+
+                    const RealBox gridloc(grids[grid_no],dx,geom.ProbLo());
+                    const int*    dlo     = dfab.loVect();
+                    const int*    dhi     = dfab.hiVect();
+                    const int*    clo     = cfab->loVect();
+                    const int*    chi     = cfab->hiVect();
+                    const int     n_der   = rec->numDerive();
+                    const int     n_state = rec->numState();
+                    const int*    dom_lo  = state[type].getDomain().loVect();
+                    const int*    dom_hi  = state[type].getDomain().hiVect();
+
+                    rec->derFunc()(dfab.dataPtr(),ARLIM(dlo),ARLIM(dhi),&n_der,
+                                   cfab->dataPtr(ccomp),ARLIM(clo),ARLIM(chi),&n_state,
+                                   lo,hi,dom_lo,dom_hi,dx,gridloc.lo(),&time,&dt,rec->getBC(),
+                                   &level,&grid_no);
+                }
+
+                FArrayBox& fab = *fabp;
+                auto       dat = fab.array();
+                //
+                // Zero out the covered cells, then reduce over the tile.
+                //
+                AMREX_HOST_DEVICE_FOR_4D ( bx, fab.nComp(), i, j, k, n,
+                {
+                    if (m(i,j,k) == 0) dat(i,j,k,n) = 0;
+                });
+
+                Real        s;
+                const int*  dlo = fab.loVect();
+                const int*  dhi = fab.hiVect();
+
+                if (q >= nsum)
+                {
+                    fort_maxval(fab.dataPtr(),ARLIM(dlo),ARLIM(dhi),ARLIM(lo),ARLIM(hi),&s);
+                    tmaxs[q-nsum] = std::max(tmaxs[q-nsum], s);
+                    continue;
+                }
+#if (BL_SPACEDIM == 2)
+                const Box& grdbx   = grids[mfi.index()];
+                int        rz_flag = Geom().IsRZ() ? 1 : 0;
+                Real*      rad     = &radius[mfi.index()][0];
+                int        irlo    = grdbx.smallEnd(0)-radius_grow;
+                int        irhi    = grdbx.bigEnd(0)+radius_grow;
+
+                if (volWgtSum_sub_dz > 0 && volWgtSum_sub_Rcyl > 0)
+                {
+                    const Real* plo = geom.ProbLo();
+                    summass_cyl(fab.dataPtr(),ARLIM(dlo),ARLIM(dhi),ARLIM(lo),ARLIM(hi),
+                                dx,&s,rad,&irlo,&irhi,&rz_flag,plo,
+                                &volWgtSum_sub_dz,&volWgtSum_sub_Rcyl);
+                }
+                else
+                {
+                    summass(fab.dataPtr(),ARLIM(dlo),ARLIM(dhi),ARLIM(lo),ARLIM(hi),
+                            dx,&s,rad,&irlo,&irhi,&rz_flag);
+                }
+#else
+                if (volWgtSum_sub_dz > 0 && volWgtSum_sub_Rcyl > 0)
+                {
+                    const Real* plo = geom.ProbLo();
+                    summass_cyl(fab.dataPtr(),ARLIM(dlo),ARLIM(dhi),ARLIM(lo),ARLIM(hi),
+                                dx,plo,&volWgtSum_sub_dz,&volWgtSum_sub_Rcyl,&s);
+                }
+                else
+                {
+                    summass(fab.dataPtr(),ARLIM(dlo),ARLIM(dhi),ARLIM(lo),ARLIM(hi),dx,&s);
+                }
+#endif
+                tsums[q] += s;
+            }
+        }
+
+#ifdef _OPENMP
+#pragma omp critical(ns_integrals)
+#endif
         {
-            summass(dat,ARLIM(dlo),ARLIM(dhi),ARLIM(lo),ARLIM(hi),
-                         dx,&s,rad,&irlo,&irhi,&rz_flag);
+            for (int q = 0; q < nsum; q++)
+                lev_sums[q] += tsums[q];
+            for (int q = 0; q < nmax; q++)
+                lev_maxs[q] = std::max(lev_maxs[q], tmaxs[q]);
         }
+    }
+
+    for (int q = 0; q < nsum; q++)
+        sums[q] += lev_sums[q];
+    for (int q = 0; q < nmax; q++)
+        maxs[q] = lev_maxs[q];
+}
+
+void
+NavierStokesBase::add_running_statistics (Real dt_stat)
+{
+    BL_PROFILE("NavierStokesBase::add_running_statistics()");
+
+    const Real      time   = state[State_Type].curTime();
+    const Real*     dx     = geom.CellSize();
+    const MultiFab& S_new  = get_new_data(State_Type);
+    MultiFab&       Stats  = get_new_data(Stats_Type);
+    //
+    // The last component holds the accumulated time.
+    //
+    const int nstats = Stats.nComp() - 1;
+    //
+    // The kernels want Rho, U, V, (W,) Tr, P in that order.
+    //
+    const int nsrc = BL_SPACEDIM + 3;
+    const int Trac = Density + 1;
+
+    MultiFab src(grids,dmap,nsrc,0);
+
+    MultiFab::Copy(src,S_new,Density,0,1,0);
+    MultiFab::Copy(src,S_new,Xvel,1,BL_SPACEDIM,0);
+    MultiFab::Copy(src,S_new,Trac,BL_SPACEDIM+1,1,0);
+
+    auto pres = derive("avg_pressure",time,0);
+    MultiFab::Copy(src,*pres,0,BL_SPACEDIM+2,1,0);
+
+#ifdef _OPENMP
+#pragma omp parallel
 #endif
+    for (MFIter mfi(Stats); mfi.isValid(); ++mfi)
+    {
+        const FArrayBox& sfab = src[mfi];
+        FArrayBox&       rfab = Stats[mfi];
 
-#if (BL_SPACEDIM == 3)
-        //
-        // Note that this routine will do a volume weighted sum of
-        // whatever quantity is passed in, not strictly the "mass".
-        //
-        if (volWgtSum_sub_dz > 0 && volWgtSum_sub_Rcyl > 0)
+        if (do_cons_trac)
         {
-            const Real* plo = geom.ProbLo();
-            summass_cyl(dat,ARLIM(dlo),ARLIM(dhi),ARLIM(lo),ARLIM(hi),
-                             dx,plo,&volWgtSum_sub_dz,&volWgtSum_sub_Rcyl,&s);
+            ns_basicstats_ctrac(sfab.dataPtr(),ARLIM(sfab.loVect()),ARLIM(sfab.hiVect()),&nsrc,
+                                rfab.dataPtr(),ARLIM(rfab.loVect()),ARLIM(rfab.hiVect()),&nstats,
+                                &dt_stat,dx);
         }
         else
         {
-            summass(dat,ARLIM(dlo),ARLIM(dhi),ARLIM(lo),ARLIM(hi),dx,&s);
+            ns_basicstats_nctrac(sfab.dataPtr(),ARLIM(sfab.loVect()),ARLIM(sfab.hiVect()),&nsrc,
+                                 rfab.dataPtr(),ARLIM(rfab.loVect()),ARLIM(rfab.hiVect()),&nstats,
+                                 &dt_stat,dx);
         }
-#endif
-        sum += s;
+
+        rfab.plus(dt_stat,nstats,1);
+    }
+}
+
+void
+NavierStokesBase::addWork (const MFIter& mfi,
+                           Real          seconds)
+{
+    if (Work_Type < 0)
+        return;
+
+    const Box& bx = mfi.tilebox();
+
+    get_new_data(Work_Type)[mfi].plus(seconds/bx.numPts(),bx,0,1);
+}
+
+int
+NavierStokesBase::WorkEstType ()
+{
+    return Work_Type;
+}
+
+void
+NavierStokesBase::remapByWork (int lbase,
+                               int new_finest)
+{
+    BL_PROFILE("NavierStokesBase::remapByWork()");
+    //
+    // Decide once per regrid, from the measured work of the new grids just
+    // filled from the old ones, which of the regridded levels are remapped:
+    // those where a knapsack of the per-box work, with the same limit on
+    // the boxes per rank as Amr's, improves the efficiency (average/maximum
+    // rank load) of the current mapping by more than load_balance_threshold.
+    // The others keep their mapping and are not rebuilt: the registers of
+    // a level live on its own distribution, so a remap of a coarser level
+    // leaves them valid.
+    //
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    Real max_fac = 1.5;
+    ParmParse ppamr("amr");
+    ppamr.query("loadbalance_max_fac",max_fac);
+
+    Vector<DistributionMapping> new_dm(new_finest+1);
+
+    for (int lev = lbase+1; lev <= new_finest; lev++)
+    {
+        const MultiFab& W = getLevel(lev).get_new_data(Work_Type);
+        const int       N = W.size();
+
+        Vector<Real> cost(N,0);
+
+        for (MFIter mfi(W); mfi.isValid(); ++mfi)
+            cost[mfi.index()] = W[mfi].sum(mfi.validbox(),0,1);
+
+        ParallelDescriptor::ReduceRealSum(cost.dataPtr(),N);
+
+        Vector<Real> load(nprocs,0);
+        Real         total = 0;
+
+        for (int i = 0; i < N; i++)
+        {
+            load[W.DistributionMap()[i]] += cost[i];
+            total                        += cost[i];
+        }
+
+        if (total <= 0)
+            continue;
+
+        const Real navg    = Real(N) / nprocs;
+        const int  nmax    = int(std::max(std::round(max_fac*navg), std::ceil(navg)));
+        const Real eff_now = total / (nprocs * *std::max_element(load.begin(),load.end()));
+        Real       eff_new = 0;
+
+        DistributionMapping dm = DistributionMapping::makeKnapSack(cost,eff_new,nmax);
+
+        const bool remap = eff_new > (1+load_balance_threshold)*eff_now;
+
+        if (verbose)
+            amrex::Print() << "NavierStokesBase::remapByWork(): level " << lev
+                           << " efficiency " << eff_now << " now, " << eff_new
+                           << " with measured work" << (remap ? ", remapping" : "") << '\n';
+
+        if (remap)
+            new_dm[lev] = dm;
     }
 
-    ParallelDescriptor::ReduceRealSum(sum);
+    for (int lev = lbase+1; lev <= new_finest; lev++)
+    {
+        if (new_dm[lev].size() == 0)
+            continue;
+
+        const BoxArray oin = getLevel(lev).old_intersect_new;
 
-    return sum;
+        parent->InstallNewDistributionMap(lev, new_dm[lev]);
+        //
+        // The rebuilt level sees the same grids; keep the overlap with the
+        // grids from before the regrid.
+        //
+        getLevel(lev).old_intersect_new = oin;
+    }
 }
 
 #if (BL_SPACEDIM == 3)
@@ -3907,13 +4951,47 @@ NavierStokesBase::sum_turbulent_quantities ()
 
     ParallelDescriptor::ReduceRealSum(&turb[0], ksize*turbVars, ParallelDescriptor::IOProcessorNumber());
 
-    if (ParallelDescriptor::IOProcessor())
+    const int steps = parent->levelSteps(0);
+
+    if (turb_stats && ParallelDescriptor::IOProcessor())
+    {
+        if (turb_acc != 0 && !turb_acc->sameShape(ksize,turbVars,turb_stats_moments))
+        {
+            amrex::Print() << "sum_turbulent_quantities(): restarting turbulence statistics,"
+                           << " the profile has changed shape\n";
+            delete turb_acc;
+            turb_acc = 0;
+        }
+
+        if (turb_acc == 0)
+        {
+            const std::string::size_type pos = turb_stats_file.rfind('/');
+            if (pos != std::string::npos)
+            {
+                const std::string dirname = turb_stats_file.substr(0, pos);
+                if (!amrex::UtilCreateDirectory(dirname, 0755))
+                    amrex::CreateDirectoryFailed(dirname);
+            }
+
+            Vector<Real> z(ksize);
+            for (int k=0; k<ksize; k++)
+                z[k] = dx[2]*(0.5+(double)k);
+
+            turb_acc = new TurbStatsAccumulator(ksize,turbVars,turb_stats_moments,z);
+        }
+
+        turb_acc->addSample(turb,time,steps);
+
+        if (turb_acc->pending() >= turb_stats_flush)
+            turb_acc->write(turb_stats_file);
+    }
+
+    if (turb_ascii && ParallelDescriptor::IOProcessor())
     {
         std::string DirPath = "TurbData";
         if (!amrex::UtilCreateDirectory(DirPath, 0755))
             amrex::CreateDirectoryFailed(DirPath);
 
-        const int steps = parent->levelSteps(0);
         FILE *file;
 
         std::string filename = amrex::Concatenate("TurbData/TurbData_", steps, 4);
@@ -3943,58 +5021,56 @@ NavierStokesBase::TurbSum (Real time, Real *turb, int ksize, int turbVars)
     auto turbMF = derive("TurbVars",time,turbGrow);
     auto presMF = derive("PresVars",time,presGrow);
 
-    BoxArray baf;
+    const iMultiFab& mask = fineCoverMask();
 
-    if (level < parent->finestLevel())
-    {
-        baf = parent->boxArray(level+1);
-        baf.coarsen(fine_ratio);
-    }
-
-    std::vector< std::pair<int,Box> > isects;
-
-    for (MFIter turbMfi(*turbMF), presMfi(*presMF);
-	 turbMfi.isValid() && presMfi.isValid();
-	 ++turbMfi, ++presMfi)
+    const int nturb = ksize*turbVars;
+    const int ntc   = turbMF->nComp();
+    const int npc   = presMF->nComp();
+    //
+    // Each thread accumulates into its own profile.  For regression
+    // testing run on one thread so that the sums are reproducible.
+    //
+#ifdef _OPENMP
+#pragma omp parallel if (!system::regtest_reduction)
+#endif
     {
-	FArrayBox& turbFab = (*turbMF)[turbMfi];
-	FArrayBox& presFab = (*presMF)[presMfi];
+        Vector<Real> tturb(nturb,0);
 
-        if (level < parent->finestLevel())
+        for (MFIter mfi(*turbMF,true); mfi.isValid(); ++mfi)
         {
-            baf.intersections(grids[turbMfi.index()],isects);
+            const Box& bx = mfi.tilebox();
+            auto       m  = mask.array(mfi);
+            auto       td = turbMF->array(mfi);
+            auto       pd = presMF->array(mfi);
 
-            for (int ii = 0, N = isects.size(); ii < N; ii++)
+            AMREX_HOST_DEVICE_FOR_4D ( bx, ntc, i, j, k, n,
             {
-                presFab.setVal(0,isects[ii].second,0,presMF->nComp());
-                turbFab.setVal(0,isects[ii].second,0,turbMF->nComp());
-            }
+                if (m(i,j,k) == 0) td(i,j,k,n) = 0;
+            });
+            AMREX_HOST_DEVICE_FOR_4D ( bx, npc, i, j, k, n,
+            {
+                if (m(i,j,k) == 0) pd(i,j,k,n) = 0;
+            });
+
+            const FArrayBox& turbFab = (*turbMF)[mfi];
+            const FArrayBox& presFab = (*presMF)[mfi];
+            const int*  dlo = turbFab.loVect();
+            const int*  dhi = turbFab.hiVect();
+            const int*  plo = presFab.loVect();
+            const int*  phi = presFab.hiVect();
+            const int*  lo  = bx.loVect();
+            const int*  hi  = bx.hiVect();
+
+            sumturb(turbFab.dataPtr(),presFab.dataPtr(),ARLIM(dlo),ARLIM(dhi),ARLIM(plo),ARLIM(phi),
+                    ARLIM(lo),ARLIM(hi),dx,tturb.dataPtr(),&ksize,&turbVars);
         }
-    }
-
-    turbMF->FillBoundary(0,turbMF->nComp(), geom.periodicity());
-    presMF->FillBoundary(0,presMF->nComp(), geom.periodicity());
-
-    for (MFIter turbMfi(*turbMF), presMfi(*presMF);
-	 turbMfi.isValid() && presMfi.isValid();
-	 ++turbMfi, ++presMfi)
-    {
-	FArrayBox& turbFab = (*turbMF)[turbMfi];
-	FArrayBox& presFab = (*presMF)[presMfi];
-
-        const Real* turbData = turbFab.dataPtr();
-        const Real* presData = presFab.dataPtr();
-        const int*  dlo = turbFab.loVect();
-        const int*  dhi = turbFab.hiVect();
-        const int*  plo = presFab.loVect();
-        const int*  phi = presFab.hiVect();
-	const Box& grdbx = grids[turbMfi.index()];
-        const int*  lo  = grdbx.loVect();
-        const int*  hi  = grdbx.hiVect();
 
-        sumturb(turbData,presData,ARLIM(dlo),ARLIM(dhi),ARLIM(plo),ARLIM(phi),ARLIM(lo),ARLIM(hi),
-		     dx,turb,&ksize,&turbVars);
-   } 
+#ifdef _OPENMP
+#pragma omp critical(ns_turbsum)
+#endif
+        for (int i = 0; i < nturb; i++)
+            turb[i] += tturb[i];
+    }
 }
 
 #ifdef SUMJET
@@ -4009,58 +5085,54 @@ NavierStokesBase::JetSum (Real time, Real *jetData, int levRsize,  int levKsize,
     auto turbMF = derive("JetVars",time,turbGrow);
     auto presMF = derive("JetPresVars",time,presGrow);
 
-    BoxArray baf;
+    const iMultiFab& mask = fineCoverMask();
 
-    if (level < parent->finestLevel())
-    {
-        baf = parent->boxArray(level+1);
-        baf.coarsen(fine_ratio);
-    }
-
-    std::vector< std::pair<int,Box> > isects;
+    const int njet = jetVars*ksize*rsize;
+    const int ntc  = turbMF->nComp();
+    const int npc  = presMF->nComp();
 
-    for (MFIter turbMfi(*turbMF), presMfi(*presMF);
-	 turbMfi.isValid() && presMfi.isValid();
-	 ++turbMfi, ++presMfi)
+#ifdef _OPENMP
+#pragma omp parallel if (!system::regtest_reduction)
+#endif
     {
-	FArrayBox& turbFab = (*turbMF)[turbMfi];
-	FArrayBox& presFab = (*presMF)[presMfi];
+        Vector<Real> tjet(njet,0);
 
-        if (level < parent->finestLevel())
+        for (MFIter mfi(*turbMF,true); mfi.isValid(); ++mfi)
         {
-            baf.intersections(grids[turbMfi.index()],isects);
+            const Box& bx = mfi.tilebox();
+            auto       m  = mask.array(mfi);
+            auto       td = turbMF->array(mfi);
+            auto       pd = presMF->array(mfi);
 
-            for (int ii = 0, N = isects.size(); ii < N; ii++)
+            AMREX_HOST_DEVICE_FOR_4D ( bx, ntc, i, j, k, n,
             {
-                presFab.setVal(0,isects[ii].second,0,presMF->nComp());
-                turbFab.setVal(0,isects[ii].second,0,turbMF->nComp());
-            }
+                if (m(i,j,k) == 0) td(i,j,k,n) = 0;
+            });
+            AMREX_HOST_DEVICE_FOR_4D ( bx, npc, i, j, k, n,
+            {
+                if (m(i,j,k) == 0) pd(i,j,k,n) = 0;
+            });
+
+            const FArrayBox& turbFab = (*turbMF)[mfi];
+            const FArrayBox& presFab = (*presMF)[mfi];
+            RealBox     gridloc  = RealBox(bx,geom.CellSize(),geom.ProbLo());
+            const int*  dlo = turbFab.loVect();
+            const int*  dhi = turbFab.hiVect();
+            const int*  plo = presFab.loVect();
+            const int*  phi = presFab.hiVect();
+            const int*  lo  = bx.loVect();
+            const int*  hi  = bx.hiVect();
+
+            sumjet(turbFab.dataPtr(),presFab.dataPtr(),ARLIM(dlo),ARLIM(dhi),ARLIM(plo),ARLIM(phi),
+                   ARLIM(lo),ARLIM(hi),dx,tjet.dataPtr(),&levRsize,&levKsize,&rsize,&ksize,
+                   &jetVars,&jet_interval_split,gridloc.lo(),gridloc.hi());
         }
-    }
-
-    turbMF->FillBoundary(0,turbMF->nComp(), geom.periodicity());
-    presMF->FillBoundary(0,presMF->nComp(), geom.periodicity());
-
-    for (MFIter turbMfi(*turbMF), presMfi(*presMF);
-	 turbMfi.isValid() && presMfi.isValid();
-	 ++turbMfi, ++presMfi)
-    {
-	FArrayBox& turbFab = (*turbMF)[turbMfi];
-	FArrayBox& presFab = (*presMF)[presMfi];
-
-        RealBox     gridloc  = RealBox(grids[turbMfi.index()],geom.CellSize(),geom.ProbLo());
-        const Real* turbData = turbFab.dataPtr();
-        const Real* presData = presFab.dataPtr();
-        const int*  dlo = turbFab.loVect();
-        const int*  dhi = turbFab.hiVect();
-        const int*  plo = presFab.loVect();
-        const int*  phi = presFab.hiVect();
-        const int*  lo  = grids[turbMfi.index()].loVect();
-        const int*  hi  = grids[turbMfi.index()].hiVect();
 
-        sumjet(turbData,presData,ARLIM(dlo),ARLIM(dhi),ARLIM(plo),ARLIM(phi),ARLIM(lo),ARLIM(hi),
-		    dx,jetData,&levRsize,&levKsize,&rsize,&ksize,&jetVars,&jet_interval_split,
-		    gridloc.lo(),gridloc.hi());
+#ifdef _OPENMP
+#pragma omp critical(ns_jetsum)
+#endif
+        for (int i = 0; i < njet; i++)
+            jetData[i] += tjet[i];
     }
 }
 
@@ -4202,6 +5274,11 @@ NavierStokesBase::read_particle_params ()
 
         ppp.getarr("timestamp_indices", timestamp_indices, 0, nc);
     }
+    //
+    // Write the timestamps in binary, buffering this many MB per rank.
+    //
+    ppp.query("timestamp_binary", timestamp_binary);
+    ppp.query("timestamp_buffer", timestamp_buffer);
 
     ppp.query("pverbose",pverbose);
     //
@@ -4213,6 +5290,16 @@ NavierStokesBase::read_particle_params ()
     //
     ppp.query("particle_restart_file", particle_restart_file);
     //
+    // Number of ranks reading a binary particle_init_file or
+    // particle_restart_file; all of them if <= 0.
+    //
+    ppp.query("particle_init_readers", particle_init_readers);
+    //
+    // Sort particles by cell after every particle_sort_int-th
+    // redistribution of a level (never if <= 0).
+    //
+    ppp.query("particle_sort_int", particle_sort_int);
+    //
     // This must be true the first time you try to restart from a checkpoint
     // that was written with USE_PARTICLES=FALSE; i.e. one that doesn't have
     // the particle checkpoint stuff (even if there are no active particles).
@@ -4239,7 +5326,7 @@ NavierStokesBase::initParticleData ()
 
         if (!particle_init_file.empty())
         {
-            NSPC->InitFromAsciiFile(particle_init_file,0);
+            init_particles_from_file(particle_init_file);
         }
     }
 }
@@ -4265,7 +5352,7 @@ NavierStokesBase::post_restart_particle ()
 
         if (!particle_restart_file.empty())
         {
-            NSPC->InitFromAsciiFile(particle_restart_file,0);
+            init_particles_from_file(particle_restart_file);
         }
 
         if (!particle_output_file.empty())
@@ -4275,6 +5362,34 @@ NavierStokesBase::post_restart_particle ()
     }
 }
 
+void
+NavierStokesBase::addParticleWork (Real seconds)
+{
+    if (Work_Type < 0 || NSPC == 0 || NSPC->ParticleBoxArray(level) != grids)
+        return;
+    //
+    // Share the time spent advecting this rank's particles of the level out
+    // over the tiles by their number of particles.
+    //
+    long ntot = 0;
+
+    for (ParIter<AMREX_SPACEDIM> pti(*NSPC, level); pti.isValid(); ++pti)
+        ntot += pti.numParticles();
+
+    if (ntot == 0)
+        return;
+
+    MultiFab&  W   = get_new_data(Work_Type);
+    const Real per = particle_work_weight * seconds / ntot;
+
+    for (ParIter<AMREX_SPACEDIM> pti(*NSPC, level); pti.isValid(); ++pti)
+    {
+        const Box& bx = pti.tilebox();
+
+        W[pti.index()].plus(per*pti.numParticles()/bx.numPts(),bx,0,1);
+    }
+}
+
 void
 NavierStokesBase::post_timestep_particle (int crse_iteration)
 {
@@ -4291,6 +5406,13 @@ NavierStokesBase::post_timestep_particle (int crse_iteration)
    
         NSPC->Redistribute(level, finest_level, ngrow);
 
+        particle_sorter.invalidateAll();
+        if (particle_sort_int > 0 && parent->levelSteps(level) % particle_sort_int == 0)
+        {
+            for (int lev = level; lev <= finest_level; lev++)
+                particle_sorter.sort(*NSPC, lev);
+        }
+
         if (!timestamp_dir.empty())
         {
             std::string basename = timestamp_dir;
@@ -4316,6 +5438,12 @@ NavierStokesBase::post_timestep_particle (int crse_iteration)
 		for (int i = 0; i < sz; ++i) {
 		    tindices.push_back(i);
 		}
+
+		if (timestamp_binary)
+		{
+		    timestamp_writer = new TimestampWriter(basename, sz,
+							   long(timestamp_buffer)*1024*1024);
+		}
 	    }
 
             for (int lev = level; lev <= finest_level; lev++)
@@ -4332,26 +5460,19 @@ NavierStokesBase::post_timestep_particle (int crse_iteration)
 		if (tindices.size() > 0)
 		{
 		    tmf.define(S_new.boxArray(), S_new.DistributionMap(), tindices.size(), ng);
-
-		    if (n > 0)
+		    //
+		    // Only fill the requested components, one FillPatch per
+		    // run of consecutive state components.
+		    //
+		    for (int i = 0; i < n; )
 		    {
-		      FillPatchIterator fpi(parent->getLevel(lev), S_new, 
-                                            ng, curr_time, State_Type, 0, NUM_STATE);
-                      const MultiFab& S = fpi.get_mf();
-		
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-                      for (MFIter mfi(tmf,true); mfi.isValid(); ++mfi)
-                      {
-                        FArrayBox& tfab = tmf[mfi];
-                        const FArrayBox& sfab = S[mfi];
-                        const Box& box = mfi.growntilebox();
-                        for (int i = 0; i < n; ++i)
-                        {
-                          tfab.copy(sfab, box, timestamp_indices[i], box, i, 1);
-                        }
-                      }
+			int nrun = 1;
+			while (i+nrun < n && timestamp_indices[i+nrun] == timestamp_indices[i]+nrun)
+			    nrun++;
+
+			FillPatch(amr_level, tmf, ng, curr_time, State_Type,
+				  timestamp_indices[i], nrun, i);
+			i += nrun;
 		    }
 
 		    if (nextras > 0)
@@ -4360,7 +5481,14 @@ NavierStokesBase::post_timestep_particle (int crse_iteration)
 		    }
 		}
 
-		NSPC->Timestamp(basename, tmf, lev, curr_time, tindices);
+		if (timestamp_writer != 0)
+		{
+		    timestamp_writer->add(*NSPC, tmf, lev, curr_time);
+		}
+		else
+		{
+		    NSPC->Timestamp(basename, tmf, lev, curr_time, tindices);
+		}
             }
         }
     }
@@ -4403,7 +5531,12 @@ NavierStokesBase::ParticleDerive (const std::string& name,
 	{
 	    MultiFab temp_dat(grids,dmap,1,0);
 	    temp_dat.setVal(0);
-	    NSPC->Increment(temp_dat,level);
+	    //
+	    // Read the counts off the bins of the last sort if the particles
+	    // haven't moved since.
+	    //
+	    if (!particle_sorter.count(*NSPC,level,temp_dat))
+		NSPC->Increment(temp_dat,level);
 	    MultiFab::Copy(mf,temp_dat,0,dcomp,1,0);
 	}
 	else if (name == "total_particle_count")
@@ -4430,7 +5563,8 @@ NavierStokesBase::ParticleDerive (const std::string& name,
 		temp_dat.setVal(0);
 		ctemp_dat.setVal(0);
 		
-		NSPC->Increment(temp_dat,lev);
+		if (!particle_sorter.count(*NSPC,lev,temp_dat))
+		    NSPC->Increment(temp_dat,lev);
 
 #ifdef _OPENMP
 #pragma omp parallel
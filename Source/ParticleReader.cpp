@@ -0,0 +1,263 @@
+
+#ifdef AMREX_PARTICLES
+
+#include <fstream>
+#include <cmath>
+#include <cstring>
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+
+#include <ParticleReader.H>
+
+using namespace amrex;
+
+namespace
+{
+    const std::string the_magic("NSParticles_V1");
+}
+
+bool
+ParticleReader::isBinary (const std::string& file)
+{
+    int binary = 0;
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        std::ifstream ifs(file.c_str(), std::ios::in|std::ios::binary);
+
+        if (!ifs.good())
+            amrex::FileOpenFailed(file);
+
+        std::vector<char> buf(the_magic.size());
+
+        ifs.read(&buf[0], buf.size());
+
+        binary = ifs.good() && std::strncmp(&buf[0], the_magic.c_str(), buf.size()) == 0;
+    }
+
+    ParallelDescriptor::Bcast(&binary, 1, ParallelDescriptor::IOProcessorNumber());
+
+    return binary;
+}
+
+void
+ParticleReader::initFromBinaryFile (AmrTracerParticleContainer& pc,
+                                    const std::string&          file,
+                                    int                         nreaders)
+{
+    BL_PROFILE("ParticleReader::initFromBinaryFile()");
+
+    const Real strttime = ParallelDescriptor::second();
+
+    const int MyProc = ParallelDescriptor::MyProc();
+    const int NProcs = ParallelDescriptor::NProcs();
+    //
+    // The IOProcessor reads the header; everybody needs the total number
+    // of particles and where the positions start.
+    //
+    long hdr[2] = { 0, 0 };   // number of particles, offset of the data
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        std::ifstream ifs(file.c_str(), std::ios::in|std::ios::binary);
+
+        if (!ifs.good())
+            amrex::FileOpenFailed(file);
+
+        std::string version, word;
+        int         dim, realsize, nchunks;
+
+        ifs >> version >> dim >> realsize >> nchunks;
+
+        if (version != the_magic || dim != BL_SPACEDIM || realsize != sizeof(Real))
+            amrex::Abort("ParticleReader: " + file + " has the wrong dimension or precision");
+
+        for (int i = 0; i < nchunks; i++)
+        {
+            long cnt;
+            ifs >> cnt;
+            hdr[0] += cnt;
+        }
+
+        while (ifs >> word && word != "END_HEADER")
+            ;
+        ifs.ignore(1);
+
+        if (!ifs.good())
+            amrex::Abort("ParticleReader: bad header in " + file);
+
+        hdr[1] = ifs.tellg();
+    }
+
+    ParallelDescriptor::Bcast(hdr, 2, ParallelDescriptor::IOProcessorNumber());
+
+    const long npart  = hdr[0];
+    const long dstart = hdr[1];
+
+    nreaders = std::max(1, std::min(nreaders, NProcs));
+    //
+    // Spread the readers over the ranks.
+    //
+    const int stride = NProcs / nreaders;
+    const int reader = (MyProc % stride == 0 && MyProc / stride < nreaders) ? MyProc / stride : -1;
+
+    const BoxArray&            ba   = pc.ParticleBoxArray(0);
+    const DistributionMapping& dm   = pc.ParticleDistributionMap(0);
+    const Geometry&            geom = pc.Geom(0);
+    const Box&                 dom  = geom.Domain();
+    //
+    // Per destination rank: the grid index and then the position of each
+    // particle, all as Reals.
+    //
+    const int nrec = BL_SPACEDIM + 1;
+
+    std::vector<std::vector<Real> > sendbuf(NProcs);
+
+    long nskipped = 0;
+
+    if (reader >= 0)
+    {
+        const long lo = (npart * reader) / nreaders;
+        const long hi = (npart * (reader+1)) / nreaders;
+
+        std::ifstream ifs(file.c_str(), std::ios::in|std::ios::binary);
+
+        if (!ifs.good())
+            amrex::FileOpenFailed(file);
+
+        ifs.seekg(dstart + lo*BL_SPACEDIM*sizeof(Real), std::ios::beg);
+
+        const long       nblock = 1 << 16;
+        std::vector<Real> pos(nblock*BL_SPACEDIM);
+        std::vector< std::pair<int,Box> > isects;
+
+        for (long start = lo; start < hi; start += nblock)
+        {
+            const long n = std::min(nblock, hi-start);
+
+            ifs.read(reinterpret_cast<char*>(&pos[0]), n*BL_SPACEDIM*sizeof(Real));
+
+            if (!ifs.good())
+                amrex::Abort("ParticleReader: failed reading " + file);
+
+            for (long i = 0; i < n; i++)
+            {
+                const Real* x = &pos[i*BL_SPACEDIM];
+
+                IntVect iv;
+                for (int d = 0; d < BL_SPACEDIM; d++)
+                    iv[d] = static_cast<int>(std::floor((x[d] - geom.ProbLo(d))/geom.CellSize(d)));
+
+                if (!dom.contains(iv))
+                {
+                    nskipped++;
+                    continue;
+                }
+
+                ba.intersections(Box(iv,iv), isects, true, 0);
+
+                if (isects.empty())
+                {
+                    nskipped++;
+                    continue;
+                }
+
+                const int grid = isects[0].first;
+
+                std::vector<Real>& buf = sendbuf[dm[grid]];
+
+                buf.push_back(grid);
+                buf.insert(buf.end(), x, x+BL_SPACEDIM);
+            }
+        }
+    }
+    //
+    // Send every particle to the rank owning its level-0 grid.
+    //
+    std::vector<Real> recvbuf;
+
+#ifdef BL_USE_MPI
+    {
+        std::vector<int> sendcnt(NProcs), recvcnt(NProcs), sdispl(NProcs), rdispl(NProcs);
+
+        for (int i = 0; i < NProcs; i++)
+            sendcnt[i] = sendbuf[i].size();
+
+        BL_MPI_REQUIRE( MPI_Alltoall(&sendcnt[0], 1, MPI_INT,
+                                     &recvcnt[0], 1, MPI_INT,
+                                     ParallelDescriptor::Communicator()) );
+
+        long stot = 0, rtot = 0;
+        for (int i = 0; i < NProcs; i++)
+        {
+            sdispl[i] = stot; stot += sendcnt[i];
+            rdispl[i] = rtot; rtot += recvcnt[i];
+        }
+
+        std::vector<Real> sendall(std::max(stot,1L));
+        for (int i = 0; i < NProcs; i++)
+        {
+            if (sendcnt[i] > 0)
+                std::memcpy(&sendall[sdispl[i]], &sendbuf[i][0], sendcnt[i]*sizeof(Real));
+            std::vector<Real>().swap(sendbuf[i]);
+        }
+
+        recvbuf.resize(std::max(rtot,1L));
+
+        BL_MPI_REQUIRE( MPI_Alltoallv(&sendall[0], &sendcnt[0], &sdispl[0],
+                                      ParallelDescriptor::Mpi_typemap<Real>::type(),
+                                      &recvbuf[0], &recvcnt[0], &rdispl[0],
+                                      ParallelDescriptor::Mpi_typemap<Real>::type(),
+                                      ParallelDescriptor::Communicator()) );
+        recvbuf.resize(rtot);
+    }
+#else
+    recvbuf.swap(sendbuf[0]);
+#endif
+    //
+    // Add the particles to their grids; Redistribute() sorts them into
+    // tiles and finer levels.
+    //
+    typedef AmrTracerParticleContainer::ParticleType ParticleType;
+
+    auto& pmap = pc.GetParticles(0);
+
+    for (long i = 0; i < long(recvbuf.size()); i += nrec)
+    {
+        const int grid = static_cast<int>(recvbuf[i]);
+
+        ParticleType p;
+
+        p.id()  = ParticleType::NextID();
+        p.cpu() = MyProc;
+
+        for (int d = 0; d < BL_SPACEDIM; d++)
+        {
+            p.pos(d)   = recvbuf[i+1+d];
+            p.rdata(d) = 0;
+        }
+
+        pmap[std::make_pair(grid,0)].push_back(p);
+    }
+
+    pc.Redistribute();
+
+    ParallelDescriptor::ReduceLongSum(nskipped);
+
+    if (pc.Verbose())
+    {
+        Real runtime = ParallelDescriptor::second() - strttime;
+
+        ParallelDescriptor::ReduceRealMax(runtime, ParallelDescriptor::IOProcessorNumber());
+
+        amrex::Print() << "ParticleReader: read " << npart - nskipped << " particles from "
+                       << file << " with " << nreaders << " readers in " << runtime
+                       << " seconds";
+        if (nskipped > 0)
+            amrex::Print() << ", skipped " << nskipped << " outside the grids";
+        amrex::Print() << '\n';
+    }
+}
+
+#endif
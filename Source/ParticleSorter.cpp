@@ -0,0 +1,157 @@
+
+#ifdef AMREX_PARTICLES
+
+#include <cmath>
+#include <type_traits>
+
+#include <ParticleSorter.H>
+
+using namespace amrex;
+
+void
+ParticleSorter::sort (AmrTracerParticleContainer& pc, int lev)
+{
+    BL_PROFILE("ParticleSorter::sort()");
+
+    if (bins.size() <= lev)
+    {
+        bins.resize(lev+1);
+        valid.resize(lev+1,0);
+    }
+
+    BinMap& bm = bins[lev];
+
+    bm.clear();
+
+    const Geometry& geom = pc.Geom(lev);
+    const Real*     plo  = geom.ProbLo();
+    const Real*     dx   = geom.CellSize();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        Vector<int> cell;
+
+        for (ParIter<AMREX_SPACEDIM> pti(pc, lev); pti.isValid(); ++pti)
+        {
+            auto&      pv  = pti.GetArrayOfStructs()();
+            const int  np  = pv.size();
+            const Box& bx  = pti.tilebox();
+            const int  nc  = bx.numPts();
+
+            Bins b;
+            b.box = bx;
+            b.offset.assign(nc+2,0);
+            //
+            // Histogram of the cell of each particle; particles outside the
+            // tile, if any, go into one last bin.
+            //
+            cell.resize(np);
+
+            for (int i = 0; i < np; i++)
+            {
+                IntVect iv;
+                for (int d = 0; d < BL_SPACEDIM; d++)
+                    iv[d] = static_cast<int>(std::floor((pv[i].pos(d) - plo[d])/dx[d]));
+
+                cell[i] = bx.contains(iv) ? bx.index(iv) : nc;
+                b.offset[cell[i]+1]++;
+            }
+
+            for (int c = 0; c <= nc; c++)
+                b.offset[c+1] += b.offset[c];
+            //
+            // Scatter into cell order.
+            //
+            typename std::remove_reference<decltype(pv)>::type sorted(np);
+
+            Vector<int> pos(b.offset.begin(), b.offset.end()-1);
+
+            for (int i = 0; i < np; i++)
+                sorted[pos[cell[i]]++] = pv[i];
+
+            pv.swap(sorted);
+
+            b.offset.pop_back();
+
+#ifdef _OPENMP
+#pragma omp critical(particle_sorter)
+#endif
+            {
+                Bins& cached = bm[std::make_pair(pti.index(),pti.LocalTileIndex())];
+                cached.box = b.box;
+                cached.offset.swap(b.offset);
+            }
+        }
+    }
+
+    valid[lev] = 1;
+}
+
+void
+ParticleSorter::invalidate (int lev)
+{
+    if (lev < valid.size())
+    {
+        valid[lev] = 0;
+        bins[lev].clear();
+    }
+}
+
+void
+ParticleSorter::invalidateAll ()
+{
+    for (int lev = 0; lev < valid.size(); lev++)
+        invalidate(lev);
+}
+
+bool
+ParticleSorter::count (const AmrTracerParticleContainer& pc,
+                       int                               lev,
+                       MultiFab&                         mf) const
+{
+    if (lev >= valid.size() || !valid[lev])
+        return false;
+
+    if (mf.boxArray() != pc.ParticleBoxArray(lev) ||
+        mf.DistributionMap() != pc.ParticleDistributionMap(lev))
+        return false;
+
+    BL_PROFILE("ParticleSorter::count()");
+
+    const BinMap& bm = bins[lev];
+    //
+    // Every cell's count is the width of its bin.
+    //
+    for (BinMap::const_iterator it = bm.begin(); it != bm.end(); ++it)
+    {
+        const Bins& b   = it->second;
+        auto        a   = mf.array(it->first.first);
+        const int*  off = b.offset.dataPtr();
+        const auto  lo  = amrex::lbound(b.box);
+        const auto  len = amrex::length(b.box);
+
+        for (int c = 0, N = b.box.numPts(); c < N; c++)
+        {
+            const int n = off[c+1] - off[c];
+
+            if (n > 0)
+            {
+                const int i = lo.x + c % len.x;
+#if (BL_SPACEDIM == 2)
+                const int j = lo.y + c / len.x;
+                const int k = 0;
+#else
+                const int j = lo.y + (c / len.x) % len.y;
+                const int k = lo.z + c / (len.x*len.y);
+#endif
+                a(i,j,k) += n;
+            }
+        }
+    }
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,189 @@
+
+#include <fstream>
+
+#include <AMReX_FPC.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+
+#include <PlaneWriter.H>
+
+using namespace amrex;
+
+PlaneWriter::PlaneWriter (const Box&         domain,
+                          int                dir_,
+                          int                loc_,
+                          const Vector<int>& comps_,
+                          int                nbuffer_,
+                          int                max_chunk,
+                          const std::string& prefix_)
+    :
+    dir(dir_),
+    loc(loc_),
+    plane(domain),
+    comps(comps_),
+    nbuffer(std::max(nbuffer_,1)),
+    prefix(prefix_)
+{
+    if (dir < 0 || dir >= BL_SPACEDIM)
+        amrex::Abort("PlaneWriter: bad plane direction");
+
+    if (loc < domain.smallEnd(dir) || loc > domain.bigEnd(dir))
+        amrex::Abort("PlaneWriter: plane is outside the domain");
+
+    if (comps.empty())
+        amrex::Abort("PlaneWriter: no components selected");
+
+    plane.setSmall(dir, loc);
+    plane.setBig  (dir, loc);
+
+    ba.define(plane);
+    ba.maxSize(max_chunk);
+    dm.define(ba);
+
+    const int ncomp = comps.size();
+
+    chunk_offset.resize(ba.size());
+    step_size = 0;
+    for (int k = 0; k < ba.size(); k++)
+    {
+        chunk_offset[k] = step_size;
+        step_size      += ba[k].numPts() * ncomp;
+    }
+    //
+    // Make sure the directory the files go into exists.
+    //
+    const std::string::size_type pos = prefix.rfind('/');
+    if (pos != std::string::npos && ParallelDescriptor::IOProcessor())
+    {
+        const std::string dirname = prefix.substr(0, pos);
+        if (!amrex::UtilCreateDirectory(dirname, 0755))
+            amrex::CreateDirectoryFailed(dirname);
+    }
+}
+
+PlaneWriter::~PlaneWriter ()
+{
+    flush();
+}
+
+std::string
+PlaneWriter::fileName () const
+{
+    const char dirname[] = { 'x', 'y', 'z' };
+
+    std::string name(prefix);
+    name += dirname[dir];
+    name += std::to_string(loc);
+    name += '_';
+
+    return amrex::Concatenate(name, steps[0], 6);
+}
+
+void
+PlaneWriter::add (const MultiFab& state, Real time, int step)
+{
+    BL_PROFILE("PlaneWriter::add()");
+
+    const int ncomp = comps.size();
+
+    buffer.emplace_back(new MultiFab(ba, dm, ncomp, 0));
+    MultiFab& mf = *buffer.back();
+    //
+    // One parallel copy per run of consecutive components.
+    //
+    for (int j = 0; j < ncomp; )
+    {
+        int n = 1;
+        while (j+n < ncomp && comps[j+n] == comps[j]+n)
+            n++;
+        mf.copy(state, comps[j], j, n);
+        j += n;
+    }
+
+    times.push_back(time);
+    steps.push_back(step);
+
+    if (buffer.size() >= nbuffer)
+        flush();
+}
+
+void
+PlaneWriter::writeHeader (const std::string& name) const
+{
+    std::ofstream ofs(name.c_str());
+    if (!ofs.good())
+        amrex::FileOpenFailed(name);
+
+    ofs.precision(17);
+
+    ofs << "PlaneWriter_V1\n";
+    ofs << FPC::NativeRealDescriptor() << '\n';
+    ofs << dir << ' ' << loc << '\n';
+    ofs << plane << '\n';
+    ofs << comps.size();
+    for (int j = 0; j < comps.size(); j++)
+        ofs << ' ' << comps[j];
+    ofs << '\n';
+    //
+    // Chunks with their offsets within a step's record, in number of Reals.
+    //
+    ofs << ba.size() << ' ' << step_size << '\n';
+    for (int k = 0; k < ba.size(); k++)
+        ofs << ba[k] << ' ' << chunk_offset[k] << '\n';
+
+    ofs << steps.size() << '\n';
+    for (int t = 0; t < steps.size(); t++)
+        ofs << steps[t] << ' ' << times[t] << '\n';
+}
+
+void
+PlaneWriter::flush ()
+{
+    if (buffer.empty()) return;
+
+    BL_PROFILE("PlaneWriter::flush()");
+
+    const std::string name = fileName();
+    const std::string dat  = name + ".dat";
+    //
+    // The IOProcessor creates the files; everybody then writes its own
+    // chunks into the data file.
+    //
+    if (ParallelDescriptor::IOProcessor())
+    {
+        writeHeader(name + ".hdr");
+
+        std::ofstream ofs(dat.c_str(), std::ios::out|std::ios::trunc|std::ios::binary);
+        if (!ofs.good())
+            amrex::FileOpenFailed(dat);
+    }
+    ParallelDescriptor::Barrier("PlaneWriter::flush");
+
+    if (buffer[0]->local_size() > 0)
+    {
+        std::fstream ofs(dat.c_str(), std::ios::in|std::ios::out|std::ios::binary);
+        if (!ofs.good())
+            amrex::FileOpenFailed(dat);
+
+        for (int t = 0; t < buffer.size(); t++)
+        {
+            const MultiFab& mf = *buffer[t];
+
+            for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+            {
+                const FArrayBox& fab = mf[mfi];
+                const long offset = (t*step_size + chunk_offset[mfi.index()]) * sizeof(Real);
+
+                ofs.seekp(offset, std::ios::beg);
+                ofs.write(reinterpret_cast<const char*>(fab.dataPtr()), fab.size()*sizeof(Real));
+            }
+        }
+
+        if (!ofs.good())
+            amrex::Abort("PlaneWriter::flush(): failed writing " + dat);
+    }
+
+    buffer.clear();
+    times.clear();
+    steps.clear();
+}
@@ -9,6 +9,8 @@
 #include <PROJECTION_F.H>
 #include <NAVIERSTOKES_F.H>
 #include <ProjOutFlowBC.H>
+#include <SolverStats.H>
+#include <NS_interp.H>
 
 #include <AMReX_MLMG.H>
 #include <AMReX_MLNodeLaplacian.H>
@@ -324,6 +326,8 @@ Projection::level_project (int             level,
       divusource->mult(dt_inv,0,1,divusource->nGrow());
 
     MultiFab Gp(grids,dmap,BL_SPACEDIM,1);
+    MemoryAccount::Tag work_tag(NavierStokesBase::theMemoryAccount(), level,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(Gp));
     ns->getGradP(Gp, prev_pres_time);
 
 #ifdef _OPENMP
@@ -670,6 +674,12 @@ Projection::MLsyncProject (int             c_lev,
     MultiFab rhnd(Pgrids_crse,Pdmap_crse,1,0);
     rhs_sync_reg->InitRHS(rhnd,crse_geom,*phys_bc);
 
+    MemoryAccount::Tag crse_tag(NavierStokesBase::theMemoryAccount(), c_lev,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(*phi[c_lev]) +
+                                                           MemoryAccount::bytes(rhnd));
+    MemoryAccount::Tag fine_tag(NavierStokesBase::theMemoryAccount(), c_lev+1,
+                                MemoryAccount::SolverWork, MemoryAccount::bytes(*phi[c_lev+1]));
+
     Box P_finedomain(amrex::surroundingNodes(crse_geom.Domain()));
     P_finedomain.refine(ratio);
     if (Pgrids_fine[0] == P_finedomain) {
@@ -1975,10 +1985,7 @@ Projection::putDown (const Vector<MultiFab*>& phi,
 
                 if (ovlp.ok())
                 {
-                    FArrayBox& cfab = phi_crse_strip[mfi];
-                    fort_putdown (BL_TO_FORTRAN(cfab),
-                                  BL_TO_FORTRAN(phi_fine_strip[iface]),
-                                  ovlp.loVect(), ovlp.hiVect(), ratio.getVect());
+                    NSInterp::putdown(ovlp, phi_fine_strip[iface], phi_crse_strip[mfi], ratio);
                 }
             }
 
@@ -2338,6 +2345,8 @@ void Projection::doMLMGNodalProjection (int c_lev, int nlevel,
         BL_ASSERT(rhcc[f_lev]->nGrow() == 1);
     }
 
+    const Real strt_time = ParallelDescriptor::second();
+
     set_boundary_velocity(c_lev, nlevel, vel, doing_initial_velproj, true);
 
     std::array<LinOpBCType,AMREX_SPACEDIM> mlmg_lobc;
@@ -2426,8 +2435,14 @@ void Projection::doMLMGNodalProjection (int c_lev, int nlevel,
     mlmg.setVerbose(P_code);
 
     Vector<MultiFab*> phi_rebase(phi.begin()+c_lev, phi.begin()+c_lev+nlevel);
+
+    const Real solve_time = ParallelDescriptor::second();
+
     Real mlmg_err = mlmg.solve(phi_rebase, amrex::GetVecOfConstPtrs(rhs), rel_tol, abs_tol);
 
+    SolverStats::add("nodal", c_lev, mlmg, solve_time - strt_time,
+                     ParallelDescriptor::second() - solve_time);
+
     if (sync_resid_fine != 0 or sync_resid_crse != 0)
     {
         set_boundary_velocity(c_lev, 1, vel, doing_initial_velproj, false);
@@ -0,0 +1,132 @@
+
+#include <map>
+#include <sstream>
+#include <utility>
+#include <algorithm>
+
+#include <AMReX_MLMG.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Vector.H>
+
+#include <SolverStats.H>
+
+using namespace amrex;
+
+namespace
+{
+    typedef std::pair<std::string,int> Key;
+
+    std::map<Key,SolverStats::Record> records;
+}
+
+void
+SolverStats::add (const std::string& kind,
+                  int                level,
+                  const MLMG&        mlmg,
+                  Real               setup_time,
+                  Real               solve_time)
+{
+    const int niters = mlmg.getNumIters();
+
+    int nbottom = 0;
+    const Vector<int>& cg_iters = mlmg.getNumCGIters();
+    for (int i = 0; i < cg_iters.size(); i++)
+        nbottom += cg_iters[i];
+
+    const Key key(kind,level);
+
+    std::map<Key,Record>::iterator it = records.find(key);
+
+    if (it == records.end())
+    {
+        const Record zero = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        it = records.insert(std::make_pair(key,zero)).first;
+    }
+
+    Record& r = it->second;
+
+    r.nsolves      += 1;
+    r.iters        += niters;
+    r.max_iters     = std::max(r.max_iters, niters);
+    r.bottom_iters += nbottom;
+    r.init_resid    = mlmg.getInitResidual();
+    r.final_resid   = mlmg.getFinalResidual();
+    r.setup_time   += setup_time;
+    r.solve_time   += solve_time;
+}
+
+const SolverStats::Record*
+SolverStats::get (const std::string& kind,
+                  int                level)
+{
+    std::map<Key,Record>::const_iterator it = records.find(Key(kind,level));
+
+    return (it == records.end()) ? 0 : &it->second;
+}
+
+std::string
+SolverStats::json ()
+{
+    const int N = records.size();
+
+    Vector<Real> times(2*N);
+
+    int i = 0;
+    for (std::map<Key,Record>::const_iterator it = records.begin(); it != records.end(); ++it, ++i)
+    {
+        times[2*i  ] = it->second.setup_time;
+        times[2*i+1] = it->second.solve_time;
+    }
+
+    if (N > 0)
+        ParallelDescriptor::ReduceRealMax(times.dataPtr(), 2*N, ParallelDescriptor::IOProcessorNumber());
+
+    if (!ParallelDescriptor::IOProcessor())
+        return std::string();
+
+    std::ostringstream os;
+
+    os.precision(6);
+
+    os << "\"solvers\":{";
+
+    std::string kind;
+    i = 0;
+    for (std::map<Key,Record>::const_iterator it = records.begin(); it != records.end(); ++it, ++i)
+    {
+        const Record& r = it->second;
+
+        if (it->first.first != kind)
+        {
+            if (!kind.empty())
+                os << "],";
+            kind = it->first.first;
+            os << '"' << kind << "\":[";
+        }
+        else
+        {
+            os << ',';
+        }
+
+        os << "{\"level\":"        << it->first.second
+           << ",\"solves\":"       << r.nsolves
+           << ",\"iters\":"        << r.iters
+           << ",\"max_iters\":"    << r.max_iters
+           << ",\"bottom_iters\":" << r.bottom_iters
+           << ",\"init_resid\":"   << r.init_resid
+           << ",\"final_resid\":"  << r.final_resid
+           << ",\"setup\":"        << times[2*i]
+           << ",\"solve\":"        << times[2*i+1] << '}';
+    }
+    if (!kind.empty())
+        os << ']';
+    os << '}';
+
+    return os.str();
+}
+
+void
+SolverStats::clear ()
+{
+    records.clear();
+}
@@ -0,0 +1,152 @@
+
+#include <fstream>
+#include <sstream>
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Vector.H>
+
+#include <StepTimer.H>
+
+using namespace amrex;
+
+StepTimer::Phase::Phase (StepTimer& timer_,
+                         int        lev_,
+                         const char* name_)
+    :
+    timer(timer_.isActive() ? &timer_ : 0),
+    lev(lev_),
+    name(name_),
+    start(0)
+{
+    if (timer)
+        start = ParallelDescriptor::second();
+}
+
+StepTimer::Phase::~Phase ()
+{
+    if (timer)
+        timer->add(lev, name, ParallelDescriptor::second() - start);
+}
+
+StepTimer::StepTimer ()
+    :
+    active(false),
+    step_start(0)
+{}
+
+void
+StepTimer::add (int                lev,
+                const std::string& name,
+                Real               secs)
+{
+    const Key key(lev,name);
+
+    seconds[key] += secs;
+    calls[key]   += 1;
+}
+
+void
+StepTimer::clear ()
+{
+    seconds.clear();
+    calls.clear();
+
+    step_start = ParallelDescriptor::second();
+}
+
+void
+StepTimer::report (const std::string& fname,
+                   int                step,
+                   Real               time,
+                   Real               dt,
+                   const std::string& extra)
+{
+    if (!active)
+        return;
+    //
+    // The phase times, and last the wall time of the step.
+    //
+    const int N = seconds.size() + 1;
+
+    Vector<Real> tmin(N), tmax(N), tsum(N);
+
+    int i = 0;
+    for (std::map<Key,Real>::const_iterator it = seconds.begin(); it != seconds.end(); ++it, ++i)
+        tmin[i] = it->second;
+    tmin[N-1] = ParallelDescriptor::second() - step_start;
+
+    tmax = tmin;
+    tsum = tmin;
+
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+
+    ParallelDescriptor::ReduceRealMin(tmin.dataPtr(), N, IOProc);
+    ParallelDescriptor::ReduceRealMax(tmax.dataPtr(), N, IOProc);
+    ParallelDescriptor::ReduceRealSum(tsum.dataPtr(), N, IOProc);
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        const int  nprocs = ParallelDescriptor::NProcs();
+        const Real rnp    = Real(1)/nprocs;
+
+        std::ostringstream os;
+
+        os.precision(12);
+
+        os << "{\"step\":"   << step
+           << ",\"time\":"   << time
+           << ",\"dt\":"     << dt
+           << ",\"nprocs\":" << nprocs;
+
+        os.precision(6);
+
+        os << ",\"wall\":{\"min\":" << tmin[N-1]
+           << ",\"avg\":"           << tsum[N-1]*rnp
+           << ",\"max\":"           << tmax[N-1] << "}"
+           << ",\"levels\":[";
+
+        int lev = -1;
+        i = 0;
+        for (std::map<Key,Real>::const_iterator it = seconds.begin(); it != seconds.end(); ++it, ++i)
+        {
+            const Key& key = it->first;
+
+            if (key.first != lev)
+            {
+                if (lev >= 0)
+                    os << "}},";
+                lev = key.first;
+                os << "{\"level\":" << lev << ",\"phases\":{";
+            }
+            else
+            {
+                os << ',';
+            }
+
+            const Real avg = tsum[i]*rnp;
+
+            os << '"' << key.second << "\":{\"calls\":" << calls[key]
+               << ",\"min\":"  << tmin[i]
+               << ",\"avg\":"  << avg
+               << ",\"max\":"  << tmax[i]
+               << ",\"wait\":" << tmax[i] - avg << '}';
+        }
+        if (lev >= 0)
+            os << "}}";
+        os << ']';
+
+        if (!extra.empty())
+            os << ',' << extra;
+
+        os << "}\n";
+
+        std::ofstream ofs(fname.c_str(), std::ios::out|std::ios::app);
+        if (!ofs.good())
+            amrex::FileOpenFailed(fname);
+
+        ofs << os.str();
+    }
+
+    clear();
+}
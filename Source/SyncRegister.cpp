@@ -1,6 +1,5 @@
 
 #include <AMReX_BC_TYPES.H>
-#include <AMReX_FluxRegister.H>
 #include <SyncRegister.H>
 //#include <NAVIERSTOKES_F.H>
 #include <SYNCREG_F.H>
@@ -17,32 +16,55 @@ SyncRegister::SyncRegister (const BoxArray& fine_boxes,
                             const IntVect&  ref_ratio)
     : ratio(ref_ratio)
 {
-    BL_ASSERT(grids.size() == 0);
     BL_ASSERT(fine_boxes.isDisjoint());
 
     grids = fine_boxes;
     grids.coarsen(ratio);
 
-    for (int dir = 0; dir < BL_SPACEDIM; dir++)
-    {
-	Orientation loface(dir, Orientation::low);
-	Orientation hiface(dir, Orientation::high);
+    const int N = grids.size();
 
-	BndryBATransformer lotrans(loface, IndexType::TheNodeType(), 0, 1, 0);
-	BndryBATransformer hitrans(hiface, IndexType::TheNodeType(), 0, 1, 0);
+    BoxList     bl(IndexType::TheNodeType());
+    Vector<int> pmap;
 
-	BoxArray loBA(grids, lotrans);
-	BoxArray hiBA(grids, hitrans);
+    bl.reserve(2*BL_SPACEDIM*N);
+    pmap.reserve(2*BL_SPACEDIM*N);
 
-        bndry[loface].define(loBA,dmap,1);
-        bndry_mask[loface].define(loBA,dmap,1);
-        bndry[hiface].define(hiBA,dmap,1);
-        bndry_mask[hiface].define(hiBA,dmap,1);
+    for (OrientationIter face; face; ++face)
+    {
+        for (int i = 0; i < N; i++)
+        {
+            bl.push_back(amrex::bdryNode(grids[i],face()));
+            pmap.push_back(dmap[i]);
+        }
     }
+
+    const BoxArray            faces(bl);
+    const DistributionMapping faces_dm(pmap);
+
+    bndry.define(faces,faces_dm,1,0);
 }
 
 SyncRegister::~SyncRegister () {}
 
+long
+SyncRegister::nBytes () const
+{
+    long n = 0;
+
+    for (MFIter mfi(bndry); mfi.isValid(); ++mfi)
+        n += bndry[mfi].nBytes();
+
+    if (bndry_mask.ok())
+        for (MFIter mfi(bndry_mask); mfi.isValid(); ++mfi)
+            n += bndry_mask[mfi].nBytes();
+
+    if (crse_buf.ok())
+        for (MFIter mfi(crse_buf); mfi.isValid(); ++mfi)
+            n += crse_buf[mfi].nBytes();
+
+    return n;
+}
+
 void /* note that rhs is on a different BoxArray */
 SyncRegister::InitRHS (MultiFab& rhs, const Geometry& geom, const BCRec& phys_bc)
 {
@@ -53,11 +75,10 @@ SyncRegister::InitRHS (MultiFab& rhs, const Geometry& geom, const BCRec& phys_bc
     int ngrow = rhs.nGrow();
 
     rhs.setVal(0);
-
-    for (OrientationIter face; face; ++face)
-    {
-        bndry[face()].copyTo(rhs,ngrow,0,0,bndry[face()].nComp(),geom.periodicity());
-    }
+    //
+    // Nodes shared by several faces hold the same value in each of them.
+    //
+    rhs.ParallelCopy(bndry,0,0,1,0,ngrow,geom.periodicity());
 
     const int* phys_lo = phys_bc.lo();
     const int* phys_hi = phys_bc.hi();
@@ -110,96 +131,96 @@ SyncRegister::InitRHS (MultiFab& rhs, const Geometry& geom, const BCRec& phys_bc
       }
     }
 
+    if (!bndry_mask.ok())
+        buildMask(geom);
+
+    // Multiply by Bndry Mask
+
+    MultiFab tmp(rhs.boxArray(), rhs.DistributionMap(), 1, ngrow);
+
+    tmp.setVal(1.0);
     //
-    // Set Up bndry_mask.
+    // The mask of a node only depends on the grids around it, not on the
+    // face it is taken from, so one copy does for all faces.
     //
-    for (OrientationIter face; face; ++face)
-    {
-        bndry_mask[face()].setVal(0);
-    }
-    
+    tmp.ParallelCopy(bndry_mask, 0, 0, 1, 0, ngrow);
+
+    MultiFab::Multiply(rhs, tmp, 0, 0, 1, ngrow);
+}
+
+void
+SyncRegister::buildMask (const Geometry& geom)
+{
+    BL_PROFILE("SyncRegister::buildMask()");
+
+    bndry_mask.define(bndry.boxArray(), bndry.DistributionMap(), 1, 0);
+    bndry_mask.setVal(0);
+
+    const Box& node_domain = amrex::surroundingNodes(geom.Domain());
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
     {
-        for (OrientationIter face_it; face_it; ++face_it)
-	{
-	    FabSet& fs = bndry_mask[face_it()];
+        FArrayBox tmpfab;
+        std::vector< std::pair<int,Box> > isects;	    
+        Vector<IntVect> pshifts(26);
 
-	    FArrayBox tmpfab;
-	    std::vector< std::pair<int,Box> > isects;	    
-	    Vector<IntVect> pshifts(26);
-
-	    for (FabSetIter fsi(fs); fsi.isValid(); ++fsi)
-	    {
-		FArrayBox& fab = fs[fsi];
+        for (MFIter mfi(bndry_mask); mfi.isValid(); ++mfi)
+        {
+            FArrayBox& fab = bndry_mask[mfi];
 		
-		Box mask_cells = amrex::enclosedCells(amrex::grow(fab.box(),1));
+            Box mask_cells = amrex::enclosedCells(amrex::grow(fab.box(),1));
 		
-		tmpfab.resize(mask_cells,1);
-		tmpfab.setVal(0);
+            tmpfab.resize(mask_cells,1);
+            tmpfab.setVal(0);
 		
-		grids.intersections(mask_cells,isects);
+            grids.intersections(mask_cells,isects);
 		
-		for (int i = 0, N = isects.size(); i < N; i++)
-		{
-		    tmpfab.setVal(1,isects[i].second,0,1);
-		}
+            for (int i = 0, N = isects.size(); i < N; i++)
+            {
+                tmpfab.setVal(1,isects[i].second,0,1);
+            }
 		
-		if (geom.isAnyPeriodic() && !geom.Domain().contains(mask_cells))
-		{
-		    geom.periodicShift(geom.Domain(),mask_cells,pshifts);
+            if (geom.isAnyPeriodic() && !geom.Domain().contains(mask_cells))
+            {
+                geom.periodicShift(geom.Domain(),mask_cells,pshifts);
 		    
-		    for (Vector<IntVect>::const_iterator it = pshifts.begin(), End = pshifts.end();
-			 it != End;
-			 ++it)
-		    {
-			const IntVect& iv = *it;
+                for (Vector<IntVect>::const_iterator it = pshifts.begin(), End = pshifts.end();
+                     it != End;
+                     ++it)
+                {
+                    const IntVect& iv = *it;
 			
-			grids.intersections(mask_cells+iv,isects);
+                    grids.intersections(mask_cells+iv,isects);
 			
-			for (int i = 0, N = isects.size(); i < N; i++)
-			{
-			    Box& isect = isects[i].second;
-			    isect     -= iv;
-			    tmpfab.setVal(1,isect,0,1);
-			}
-		    }
-		}
-		Real* mask_dat = fab.dataPtr();
-		const int* mlo = fab.loVect(); 
-		const int* mhi = fab.hiVect();
-		Real* cell_dat = tmpfab.dataPtr();
-		const int* clo = tmpfab.loVect(); 
-		const int* chi = tmpfab.hiVect();
+                    for (int i = 0, N = isects.size(); i < N; i++)
+                    {
+                        Box& isect = isects[i].second;
+                        isect     -= iv;
+                        tmpfab.setVal(1,isect,0,1);
+                    }
+                }
+            }
+            Real* mask_dat = fab.dataPtr();
+            const int* mlo = fab.loVect(); 
+            const int* mhi = fab.hiVect();
+            Real* cell_dat = tmpfab.dataPtr();
+            const int* clo = tmpfab.loVect(); 
+            const int* chi = tmpfab.hiVect();
 		
-		makemask(mask_dat,ARLIM(mlo),ARLIM(mhi), cell_dat,ARLIM(clo),ARLIM(chi));
-	    }
-        }
-    }
-
-    //
-    // Here double the cell contributions if at a non-periodic physical bdry.
-    //
-    for (int dir = 0; dir < BL_SPACEDIM; dir++)
-    {
-        if (!geom.isPeriodic(dir))
-        {
-            Box domlo(node_domain), domhi(node_domain);
-
-            domlo.setRange(dir,node_domain.smallEnd(dir),1);
-            domhi.setRange(dir,node_domain.bigEnd(dir),1);
-
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-            for (OrientationIter face_it; face_it; ++face_it)
+            makemask(mask_dat,ARLIM(mlo),ARLIM(mhi), cell_dat,ARLIM(clo),ARLIM(chi));
+            //
+            // Here double the cell contributions if at a non-periodic physical bdry.
+            //
+            for (int dir = 0; dir < BL_SPACEDIM; dir++)
             {
-                FabSet& fs = bndry_mask[face_it()];
-
-                for (FabSetIter fsi(fs); fsi.isValid(); ++fsi)
+                if (!geom.isPeriodic(dir))
                 {
-                    FArrayBox& fab = fs[fsi];
+                    Box domlo(node_domain), domhi(node_domain);
+
+                    domlo.setRange(dir,node_domain.smallEnd(dir),1);
+                    domhi.setRange(dir,node_domain.bigEnd(dir),1);
 
                     const Box& blo = fab.box() & domlo;
 
@@ -212,43 +233,12 @@ SyncRegister::InitRHS (MultiFab& rhs, const Geometry& geom, const BCRec& phys_bc
                         fab.mult(2.0,bhi,0,1);
                 }
             }
-        }
-    }
-    //
-    // Here convert from sum of cell contributions to 0 or 1.
-    //
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-    for (OrientationIter face_it; face_it; ++face_it)
-    {
-        FabSet& fs = bndry_mask[face_it()];
-
-        for (FabSetIter fsi(fs); fsi.isValid(); ++fsi)
-        {
-            FArrayBox& fab      = fs[fsi];
-            Real*      mask_dat = fab.dataPtr();
-            const int* mlo      = fab.loVect(); 
-            const int* mhi      = fab.hiVect();
-
+            //
+            // Here convert from sum of cell contributions to 0 or 1.
+            //
             convertmask(mask_dat,ARLIM(mlo),ARLIM(mhi));
         }
     }
-
-    // Multiply by Bndry Mask
-
-    MultiFab tmp(rhs.boxArray(), rhs.DistributionMap(), 1, ngrow);
-
-    for (OrientationIter face; face; ++face)
-    {
-        BL_ASSERT(bndry_mask[face()].nComp() == 1);
-	
-	tmp.setVal(1.0);
-
-	bndry_mask[face()].copyTo(tmp, ngrow, 0, 0, 1);
-
-	MultiFab::Multiply(rhs, tmp, 0, 0, 1, ngrow);
-    }
 }
 
 void
@@ -256,14 +246,11 @@ SyncRegister::CrseInit (MultiFab& Sync_resid_crse, const Geometry& crse_geom, Re
 {
     BL_PROFILE("SyncRegister::CrseInit()");
 
-    setVal(0);
+    bndry.setVal(0);
 
     Sync_resid_crse.mult(mult);
 
-    for (OrientationIter face; face; ++face)
-    {
-        bndry[face()].plusFrom(Sync_resid_crse,0,0,0,1,crse_geom.periodicity());
-    }
+    bndry.ParallelCopy(Sync_resid_crse,0,0,1,0,0,crse_geom.periodicity(),FabArrayBase::ADD);
 }
 
 void
@@ -323,7 +310,14 @@ SyncRegister::FineAdd (MultiFab& Sync_resid_fine, const Geometry& crse_geom, Rea
     BoxArray cba = Sync_resid_fine.boxArray();
     cba.coarsen(ratio);
 
-    MultiFab Sync_resid_crse(cba, Sync_resid_fine.DistributionMap(), 1, 0);
+    if (!crse_buf.ok() || !(crse_buf.boxArray() == cba) ||
+        crse_buf.DistributionMap() != Sync_resid_fine.DistributionMap())
+    {
+        crse_buf.clear();
+        crse_buf.define(cba, Sync_resid_fine.DistributionMap(), 1, 0);
+    }
+
+    MultiFab& Sync_resid_crse = crse_buf;
     Sync_resid_crse.setVal(0.0);
 
 #ifdef _OPENMP
@@ -395,9 +389,6 @@ SyncRegister::FineAdd (MultiFab& Sync_resid_fine, const Geometry& crse_geom, Rea
         }
     }
 
-    for (OrientationIter face; face; ++face)
-    {
-	bndry[face()].plusFrom(Sync_resid_crse,0,0,0,1,crse_geom.periodicity());
-    }
+    bndry.ParallelCopy(Sync_resid_crse,0,0,1,0,0,crse_geom.periodicity(),FabArrayBase::ADD);
 }
 
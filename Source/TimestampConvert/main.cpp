@@ -0,0 +1,119 @@
+//
+// Converts the binary particle timestamp files written with
+// particles.timestamp_binary = 1 into the text records written by
+// TracerParticleContainer::Timestamp():
+//
+//   id cpu x y [z] time u v [w] vals...
+//
+// Usage: tsconvert.ex Timestamp_00000.bin [Timestamp_00001.bin ...]
+//
+// Each <name>.bin is converted to <name>.  The files must have been
+// written on a machine with the same byte order.
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    template <class T>
+    void
+    convert (std::istream& is,
+             std::ostream& os,
+             int           dim,
+             int           ncomp)
+    {
+        const int nreal = 2*dim + 1 + ncomp;
+
+        std::vector<T> rec(nreal);
+        int            ids[2];
+
+        while (is.read(reinterpret_cast<char*>(ids), sizeof(ids)))
+        {
+            if (!is.read(reinterpret_cast<char*>(&rec[0]), nreal*sizeof(T)))
+            {
+                std::cerr << "  truncated record, stopping\n";
+                break;
+            }
+
+            os << ids[0] << ' ' << ids[1] << ' ';
+            for (int d = 0; d < dim; d++)
+                os << rec[d] << ' ';
+            os << rec[dim];
+            for (int i = dim+1; i < nreal; i++)
+                os << ' ' << rec[i];
+            os << '\n';
+        }
+    }
+
+    bool
+    convertFile (const std::string& in)
+    {
+        std::ifstream ifs(in.c_str(), std::ios::in|std::ios::binary);
+
+        if (!ifs.good())
+        {
+            std::cerr << "Couldn't open " << in << '\n';
+            return false;
+        }
+
+        std::string version, rd;
+        int         dim, ncomp, realsize;
+
+        ifs >> version >> dim >> ncomp >> realsize;
+        ifs.ignore(1);
+        std::getline(ifs, rd);
+
+        if (version != "TimestampBin_V1" || (realsize != sizeof(float) && realsize != sizeof(double)))
+        {
+            std::cerr << in << " is not a binary timestamp file\n";
+            return false;
+        }
+
+        std::string out = in;
+        if (out.size() > 4 && out.compare(out.size()-4, 4, ".bin") == 0)
+            out.erase(out.size()-4);
+        else
+            out += ".txt";
+
+        std::ofstream ofs(out.c_str());
+
+        if (!ofs.good())
+        {
+            std::cerr << "Couldn't open " << out << '\n';
+            return false;
+        }
+
+        ofs.setf(std::ios_base::scientific,std::ios_base::floatfield);
+        ofs.precision(10);
+
+        if (realsize == sizeof(double))
+            convert<double>(ifs, ofs, dim, ncomp);
+        else
+            convert<float>(ifs, ofs, dim, ncomp);
+
+        std::cout << in << " -> " << out << '\n';
+
+        return ofs.good();
+    }
+}
+
+int
+main (int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " Timestamp_00000.bin [Timestamp_00001.bin ...]\n";
+        return EXIT_FAILURE;
+    }
+
+    bool ok = true;
+
+    for (int i = 1; i < argc; i++)
+        ok = convertFile(argv[i]) && ok;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,186 @@
+
+#ifdef AMREX_PARTICLES
+
+#include <fstream>
+#include <cmath>
+#include <cstring>
+
+#include <AMReX_FPC.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+
+#include <TimestampWriter.H>
+
+using namespace amrex;
+
+TimestampWriter::TimestampWriter (const std::string& basename,
+                                  int                ncomp_,
+                                  long               buffer_size_)
+    :
+    ncomp(ncomp_),
+    buffer_size(std::max(buffer_size_,1L))
+{
+    filename  = amrex::Concatenate(basename + '_', ParallelDescriptor::MyProc(), 5);
+    filename += ".bin";
+
+    record_size = 2*sizeof(int) + (2*BL_SPACEDIM + 1 + ncomp)*sizeof(Real);
+
+    buffer.reserve(buffer_size + record_size);
+}
+
+TimestampWriter::~TimestampWriter ()
+{
+    flush();
+}
+
+void
+TimestampWriter::add (AmrTracerParticleContainer& pc,
+                      const MultiFab&             mf,
+                      int                         lev,
+                      Real                        time)
+{
+    BL_PROFILE("TimestampWriter::add()");
+
+    const Geometry& geom = pc.Geom(lev);
+    const Real*     plo  = geom.ProbLo();
+    const Real*     dx   = geom.CellSize();
+
+    Real dxi[BL_SPACEDIM];
+    for (int d = 0; d < BL_SPACEDIM; d++)
+        dxi[d] = 1.0/dx[d];
+
+    const int nc = ncomp;
+    const int nw = 1 << BL_SPACEDIM;
+
+    std::vector<int>  pidx;
+    std::vector<int>  cell;
+    std::vector<Real> wgt;
+    std::vector<Real> vals;
+
+    for (ParIter<AMREX_SPACEDIM> pti(pc, lev); pti.isValid(); ++pti)
+    {
+        const auto& aos = pti.GetArrayOfStructs();
+        const int   np  = aos.size();
+
+        if (np == 0) continue;
+        //
+        // Lower corner of each particle's interpolation stencil and the
+        // linear weights; the components are then gathered one at a time.
+        //
+        pidx.clear();
+        cell.resize(np*BL_SPACEDIM);
+        wgt.resize(np*nw);
+
+        for (int ip = 0; ip < np; ip++)
+        {
+            const auto& p = aos[ip];
+
+            if (p.id() <= 0) continue;
+
+            const int m = pidx.size();
+
+            Real fr[BL_SPACEDIM];
+            for (int d = 0; d < BL_SPACEDIM; d++)
+            {
+                const Real l  = (p.pos(d) - plo[d])*dxi[d] - 0.5;
+                const int  il = static_cast<int>(std::floor(l));
+                cell[m*BL_SPACEDIM+d] = il;
+                fr[d] = l - il;
+            }
+
+            for (int c = 0; c < nw; c++)
+            {
+                Real w = 1;
+                for (int d = 0; d < BL_SPACEDIM; d++)
+                    w *= ((c >> d) & 1) ? fr[d] : 1-fr[d];
+                wgt[m*nw+c] = w;
+            }
+
+            pidx.push_back(ip);
+        }
+
+        const int npart = pidx.size();
+
+        if (npart == 0) continue;
+
+        vals.assign(npart*nc,0);
+
+        if (nc > 0)
+        {
+            const auto a = mf.array(pti);
+
+            for (int n = 0; n < nc; n++)
+            {
+                for (int m = 0; m < npart; m++)
+                {
+                    const int* iv = &cell[m*BL_SPACEDIM];
+                    const Real* w = &wgt[m*nw];
+#if (BL_SPACEDIM == 2)
+                    vals[m*nc+n] = w[0]*a(iv[0]  ,iv[1]  ,0,n) + w[1]*a(iv[0]+1,iv[1]  ,0,n)
+                                 + w[2]*a(iv[0]  ,iv[1]+1,0,n) + w[3]*a(iv[0]+1,iv[1]+1,0,n);
+#else
+                    vals[m*nc+n] = w[0]*a(iv[0]  ,iv[1]  ,iv[2]  ,n) + w[1]*a(iv[0]+1,iv[1]  ,iv[2]  ,n)
+                                 + w[2]*a(iv[0]  ,iv[1]+1,iv[2]  ,n) + w[3]*a(iv[0]+1,iv[1]+1,iv[2]  ,n)
+                                 + w[4]*a(iv[0]  ,iv[1]  ,iv[2]+1,n) + w[5]*a(iv[0]+1,iv[1]  ,iv[2]+1,n)
+                                 + w[6]*a(iv[0]  ,iv[1]+1,iv[2]+1,n) + w[7]*a(iv[0]+1,iv[1]+1,iv[2]+1,n);
+#endif
+                }
+            }
+        }
+        //
+        // Pack the records.
+        //
+        const long old_size = buffer.size();
+        buffer.resize(old_size + npart*record_size);
+        char* b = &buffer[old_size];
+
+        for (int m = 0; m < npart; m++)
+        {
+            const auto& p = aos[pidx[m]];
+
+            const int  ids[2] = { p.id(), p.cpu() };
+            Real       rec[2*BL_SPACEDIM+1];
+            for (int d = 0; d < BL_SPACEDIM; d++)
+            {
+                rec[d]               = p.pos(d);
+                rec[BL_SPACEDIM+1+d] = p.rdata(d);
+            }
+            rec[BL_SPACEDIM] = time;
+
+            std::memcpy(b, ids, sizeof(ids));             b += sizeof(ids);
+            std::memcpy(b, rec, sizeof(rec));             b += sizeof(rec);
+            std::memcpy(b, &vals[m*nc], nc*sizeof(Real)); b += nc*sizeof(Real);
+        }
+    }
+
+    if (static_cast<long>(buffer.size()) >= buffer_size)
+        flush();
+}
+
+void
+TimestampWriter::flush ()
+{
+    if (buffer.empty()) return;
+
+    BL_PROFILE("TimestampWriter::flush()");
+
+    std::ofstream ofs(filename.c_str(), std::ios::out|std::ios::app|std::ios::binary);
+    if (!ofs.good())
+        amrex::FileOpenFailed(filename);
+
+    if (ofs.tellp() == std::streampos(0))
+    {
+        ofs << "TimestampBin_V1\n";
+        ofs << BL_SPACEDIM << ' ' << ncomp << ' ' << sizeof(Real) << '\n';
+        ofs << FPC::NativeRealDescriptor() << '\n';
+    }
+
+    ofs.write(&buffer[0], buffer.size());
+
+    if (!ofs.good())
+        amrex::Abort("TimestampWriter::flush(): failed writing " + filename);
+
+    buffer.clear();
+}
+
+#endif
@@ -0,0 +1,236 @@
+
+#include <fstream>
+
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <AMReX_FPC.H>
+#include <AMReX_Utility.H>
+
+#include <TurbStats.H>
+
+using namespace amrex;
+
+namespace
+{
+    const std::string the_turb_stats_file_name("TurbStats");
+
+    bool
+    fileExists (const std::string& name, long* size = 0)
+    {
+        struct stat sb;
+
+        if (stat(name.c_str(), &sb) != 0)
+            return false;
+
+        if (size != 0)
+            *size = sb.st_size;
+
+        return true;
+    }
+}
+
+TurbStatsAccumulator::TurbStatsAccumulator (int                 ksize_,
+                                            int                 nvars_,
+                                            int                 nmoments_,
+                                            const Vector<Real>& z_)
+    :
+    ksize(ksize_),
+    nvars(nvars_),
+    nmoments(nmoments_),
+    z(z_),
+    mean(nmoments_*ksize_*nvars_,0),
+    nsamples(0),
+    n_pending(0),
+    last_step(-1),
+    start_time(0),
+    last_time(0),
+    weight(0),
+    file_size(-1)
+{
+    if (nmoments < 1)
+        amrex::Abort("TurbStatsAccumulator: need at least one moment");
+
+    if (z.size() != ksize)
+        amrex::Abort("TurbStatsAccumulator: z has the wrong length");
+}
+
+bool
+TurbStatsAccumulator::sameShape (int ksize_, int nvars_, int nmoments_) const
+{
+    return ksize == ksize_ && nvars == nvars_ && nmoments == nmoments_;
+}
+
+void
+TurbStatsAccumulator::addSample (const Real* profile,
+                                 Real        time,
+                                 int         step)
+{
+    if (nsamples == 0 && weight == 0)
+    {
+        //
+        // The first sample only starts the clock.
+        //
+        start_time = last_time = time;
+        last_step  = step;
+        nsamples   = 1;
+        n_pending++;
+        return;
+    }
+
+    const Real w = time - last_time;
+
+    if (w <= 0) return;
+
+    weight   += w;
+    last_time = time;
+    last_step = step;
+    nsamples++;
+    n_pending++;
+    //
+    // Incremental weighted mean of each power of each quantity.
+    //
+    const Real f  = w / weight;
+    const int  nz = ksize*nvars;
+
+    for (int i = 0; i < nz; i++)
+    {
+        const Real x = profile[i];
+        Real       p = x;
+
+        for (int m = 0; m < nmoments; m++)
+        {
+            Real& mu = mean[m*nz+i];
+            mu += f*(p - mu);
+            p  *= x;
+        }
+    }
+}
+
+void
+TurbStatsAccumulator::writeHeader (std::ostream& os) const
+{
+    os.precision(17);
+
+    os << "TurbStats_V1\n";
+    os << ksize << ' ' << nvars << ' ' << nmoments << ' ' << sizeof(Real) << '\n';
+    os << FPC::NativeRealDescriptor() << '\n';
+    for (int k = 0; k < ksize; k++)
+        os << z[k] << (k == ksize-1 ? '\n' : ' ');
+    os << "END_HEADER\n";
+}
+
+void
+TurbStatsAccumulator::checkHeader (const std::string& fname) const
+{
+    std::ifstream ifs(fname.c_str());
+    if (!ifs.good())
+        amrex::FileOpenFailed(fname);
+
+    std::string version;
+    int         ks, nv, nm, rs;
+
+    ifs >> version >> ks >> nv >> nm >> rs;
+
+    if (version != "TurbStats_V1" || !sameShape(ks,nv,nm) || rs != sizeof(Real))
+        amrex::Abort("TurbStatsAccumulator: " + fname + " holds records of a different shape");
+}
+
+void
+TurbStatsAccumulator::write (const std::string& fname)
+{
+    if (file_size < 0 && fileExists(fname))
+        checkHeader(fname);
+
+    std::ofstream ofs(fname.c_str(), std::ios::out|std::ios::app|std::ios::binary);
+    if (!ofs.good())
+        amrex::FileOpenFailed(fname);
+
+    if (ofs.tellp() == std::streampos(0))
+        writeHeader(ofs);
+
+    const Real rec[3] = { last_time, start_time, weight };
+
+    ofs.write(reinterpret_cast<const char*>(&last_step), sizeof(int));
+    ofs.write(reinterpret_cast<const char*>(&nsamples),  sizeof(int));
+    ofs.write(reinterpret_cast<const char*>(rec),        3*sizeof(Real));
+    ofs.write(reinterpret_cast<const char*>(mean.dataPtr()), mean.size()*sizeof(Real));
+
+    if (!ofs.good())
+        amrex::Abort("TurbStatsAccumulator: failed writing " + fname);
+
+    file_size = ofs.tellp();
+    n_pending = 0;
+}
+
+void
+TurbStatsAccumulator::checkPoint (const std::string& dir) const
+{
+    const std::string fname = dir + "/" + the_turb_stats_file_name;
+
+    std::ofstream ofs(fname.c_str(), std::ios::out|std::ios::trunc|std::ios::binary);
+    if (!ofs.good())
+        amrex::FileOpenFailed(fname);
+
+    ofs.precision(17);
+
+    ofs << "TurbStatsChk_V1\n";
+    ofs << ksize << ' ' << nvars << ' ' << nmoments << ' '
+        << nsamples << ' ' << last_step << ' ' << file_size << '\n';
+    ofs << start_time << ' ' << last_time << ' ' << weight << '\n';
+    for (int k = 0; k < ksize; k++)
+        ofs << z[k] << (k == ksize-1 ? '\n' : ' ');
+    ofs.write(reinterpret_cast<const char*>(mean.dataPtr()), mean.size()*sizeof(Real));
+
+    if (!ofs.good())
+        amrex::Abort("TurbStatsAccumulator: failed writing " + fname);
+}
+
+TurbStatsAccumulator*
+TurbStatsAccumulator::restart (const std::string& dir)
+{
+    const std::string fname = dir + "/" + the_turb_stats_file_name;
+
+    if (!fileExists(fname))
+        return 0;
+
+    std::ifstream ifs(fname.c_str(), std::ios::in|std::ios::binary);
+    if (!ifs.good())
+        amrex::FileOpenFailed(fname);
+
+    std::string version;
+    int         ks, nv, nm;
+
+    ifs >> version >> ks >> nv >> nm;
+
+    if (version != "TurbStatsChk_V1")
+        amrex::Abort("TurbStatsAccumulator: bad version in " + fname);
+
+    Vector<Real> z(ks);
+
+    TurbStatsAccumulator* ts = new TurbStatsAccumulator(ks,nv,nm,z);
+
+    ifs >> ts->nsamples >> ts->last_step >> ts->file_size;
+    ifs >> ts->start_time >> ts->last_time >> ts->weight;
+    for (int k = 0; k < ks; k++)
+        ifs >> ts->z[k];
+    ifs.ignore(1);
+    ifs.read(reinterpret_cast<char*>(ts->mean.dataPtr()), ts->mean.size()*sizeof(Real));
+
+    if (!ifs.good())
+        amrex::Abort("TurbStatsAccumulator: failed reading " + fname);
+
+    return ts;
+}
+
+void
+TurbStatsAccumulator::truncate (const std::string& fname) const
+{
+    long size;
+
+    if (file_size < 0 || !fileExists(fname,&size) || size <= file_size)
+        return;
+
+    if (::truncate(fname.c_str(), file_size) != 0)
+        amrex::Abort("TurbStatsAccumulator: failed truncating " + fname);
+}